@@ -1,197 +1,140 @@
-#include <iostream>
-#include <vector>
-#include <queue>
-#include <climits>
-#include <cstdlib> // for rand()
-#include <unordered_set>
 #include <chrono>
-#include <bits/stdc++.h>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "sasap/BicriteriaFptas.h"
+#include "sasap/MemoryUsage.h"
+#include "sasap/Profiler.h"
+#include "sasap/Random.h"
+#include "sasap/QoS.h"
+#include "sasap/WorkStealingPool.h"
+#include "sasap/WorkflowIO.h"
+#include "sasap/WorkflowTree.h"
 
 using namespace std;
+using sasap::WorkflowTree;
 
-struct TreeNode {
-    int id;
-    int cost;
-    int latency;
-    std::vector<TreeNode*> children;
-    TreeNode(int id, int cost, int latency) : id(id), cost(cost), latency(latency) {}
-};
-
-// Declaration of findTreeNode function
-TreeNode* findTreeNode(TreeNode* root, int id);
+// Composite functions (partitions) stored in CSR form, with their totals
+using CompositeFunctions = sasap::BicriteriaResult;
 
 // Declaration of printCompositeFunctions function
-void printCompositeFunctions(const std::vector<std::unordered_set<int>>& compositeFunctions, TreeNode* root);
-
-// Declaration of dfs function
-void dfs(TreeNode* node, int latencyLimit, std::unordered_set<int>& currentPartition, std::unordered_set<TreeNode*>& visited);
-
-// Function to calculate QoS satisfaction for a partition
-double calculatePartitionQoS(int totalCost, int totalLatency, int costLimit, int latencyLimit) {
-    double costSatisfaction = (costLimit - totalCost) * 100.0 / costLimit;
-    double latencySatisfaction = (latencyLimit - totalLatency) * 100.0 / latencyLimit;
-
-    // Ensure the satisfaction is between 0 and 100%
-    costSatisfaction = std::max(0.0, costSatisfaction);
-    latencySatisfaction = std::max(0.0, latencySatisfaction);
-
-    return (costSatisfaction + latencySatisfaction) / 2;
+void printCompositeFunctions(const CompositeFunctions& compositeFunctions);
+
+// Function to perform bicriteria approximation and partition tree nodes.
+// The tree DP minimises the number of composite functions subject to latencyLimit, with each
+// composite function allowed to exceed costLimit by at most a factor (1 + epsilon).
+// With a pool, independent subtrees are solved concurrently; the result is the same.
+void bicriteriaApproximation(const WorkflowTree& tree, int latencyLimit, int costLimit, const sasap::BicriteriaOptions& options,
+                             CompositeFunctions& compositeFunctions, double& overallQoS, sasap::WorkStealingPool* pool = nullptr) {
+    compositeFunctions = pool ? sasap::bicriteriaPartition(tree, latencyLimit, costLimit, options, *pool)
+                              : sasap::bicriteriaPartition(tree, latencyLimit, costLimit, options);
+
+    // Mean QoS satisfaction over all partitions from their true totals; each of cost and
+    // latency contributes its headroom, clamped to [0, 100]%
+    overallQoS = sasap::evaluateQoS(compositeFunctions.totalCost.data(), compositeFunctions.totalLatency.data(), compositeFunctions.size(),
+                                    costLimit, latencyLimit, sasap::QoSModel::Headroom);
 }
 
-// Function to perform bicriteria approximation and partition tree nodes
-void bicriteriaApproximation(TreeNode* root, int latencyLimit, int costLimit, std::vector<std::unordered_set<int>>& compositeFunctions, double& overallQoS) {
-    std::unordered_set<TreeNode*> visited;
-
-    // Perform DFS to assign nodes to composite functions
-    for (TreeNode* node : root->children) {
-        if (visited.find(node) == visited.end()) {
-            std::unordered_set<int> currentPartition;
-            int totalCost = 0;
-            int totalLatency = 0;
-
-            dfs(node, latencyLimit, currentPartition, visited);
-
-            if (!currentPartition.empty()) {
-                // Calculate total cost and latency for this partition
-                for (int id : currentPartition) {
-                    totalCost += node->cost;
-                    totalLatency += node->latency;
-                }
-
-                // Calculate QoS satisfaction for the partition
-                double partitionQoS = calculatePartitionQoS(totalCost, totalLatency, costLimit, latencyLimit);
-                overallQoS += partitionQoS;
-
-                // Add partition to composite functions
-                compositeFunctions.push_back(std::move(currentPartition));
-            }
-        }
-    }
-}
+// Function to print composite functions in a hierarchical (breadth-first) manner
+void printCompositeFunctions(const CompositeFunctions& compositeFunctions) {
+    std::cout << "Partitions (Composite Functions):" << '\n';
 
-// DFS to assign nodes to composite functions
-void dfs(TreeNode* node, int latencyLimit, std::unordered_set<int>& currentPartition, std::unordered_set<TreeNode*>& visited) {
-    visited.insert(node);
-    currentPartition.insert(node->id);
-
-    for (TreeNode* child : node->children) {
-        if (visited.find(child) == visited.end() && node->latency + child->latency <= latencyLimit) {
-            dfs(child, latencyLimit - node->latency, currentPartition, visited);
+    for (std::size_t f = 0; f < compositeFunctions.size(); ++f) {
+        // Print composite function header
+        std::cout << "Partition " << f + 1 << " :";
+        for (int i = compositeFunctions.offset[f]; i < compositeFunctions.offset[f + 1]; ++i) {
+            std::cout << " " << compositeFunctions.nodes[i];
         }
+        std::cout << '\n';
     }
+    std::cout.flush();
 }
 
-// Function to print composite functions in a hierarchical manner
-void printCompositeFunctions(const std::vector<std::unordered_set<int>>& compositeFunctions, TreeNode* root) {
-    std::cout << "Partitions (Composite Functions):" << std::endl;
-    int partitionNum = 0;
-
-    for (const auto& partition : compositeFunctions) {
-        partitionNum++;
-
-        // Print composite function header
-        std::cout << "Partition " << partitionNum << " :";
-
-        // Collect nodes in composite function in a hierarchical manner
-        std::queue<int> nodeQueue;
-        std::unordered_set<int> visited;
-
-        // Push all nodes of the current partition into the queue
-        for (int id : partition) {
-            nodeQueue.push(id);
-            visited.insert(id);
-        }
-
-        // BFS to collect nodes in a hierarchical order
-        while (!nodeQueue.empty()) {
-            int currentId = nodeQueue.front();
-            nodeQueue.pop();
-
-            std::cout << " " << currentId;
-
-            TreeNode* currentNode = findTreeNode(root, currentId);
-            if (currentNode) {
-                for (TreeNode* child : currentNode->children) {
-                    if (visited.find(child->id) == visited.end()) {
-                        visited.insert(child->id);
-                        nodeQueue.push(child->id);
-                    }
-                }
-            }
-        }
-
-        std::cout << std::endl;
+int main(int argc, char* argv[]) {
+    if (argc > 5) {
+        std::cerr << "Usage: " << argv[0] << " [number_of_nodes|workflow_file] [epsilon] [partitioning_threads] [seed]" << std::endl;
+        return 1;
     }
-}
 
-// Helper function to find a TreeNode by its ID in the tree
-TreeNode* findTreeNode(TreeNode* root, int id) {
-    if (!root) return nullptr;
-    if (root->id == id) return root;
+    std::string input = argc >= 2 ? argv[1] : "500";   // Node count of a random tree, or a workflow file
+    int N = sasap::isNodeCount(input) ? std::stoi(input) : -1;
 
-    for (TreeNode* child : root->children) {
-        TreeNode* found = findTreeNode(child, id);
-        if (found) return found;
+    // Approximation parameter: smaller values give better partitions at higher DP cost
+    sasap::BicriteriaOptions options;
+    if (argc >= 3) {
+        options.epsilon = std::stod(argv[2]);
+        if (!(options.epsilon > 0.0)) {
+            std::cerr << "Epsilon must be positive." << std::endl;
+            return 1;
+        }
     }
 
-    return nullptr;
-}
+    int partitioningThreads = argc >= 4 ? std::stoi(argv[3]) : 0;   // 0 partitions on the calling thread
+    std::uint64_t seed = argc == 5 ? std::stoull(argv[4]) : sasap::freshSeed();   // Seed of the generated tree
 
-int main() {
-    int N = 500;
-    if (N < 1 || N > 500) {
-        std::cerr << "Number of nodes must be between 1 and 500." << std::endl;
+    if (N == 0 || partitioningThreads < 0) {
+        std::cerr << "Number of nodes must be at least 1 and the thread count non-negative." << std::endl;
         return 1;
     }
 
-    // Seed for random number generation
-    srand(time(0));
-
-    // Create tree structure with random costs and latencies
-    std::vector<TreeNode*> nodes(N);
-    for (int i = 0; i < N; ++i) {
-        int cost = rand() % 50 + 1;   // Random cost between 1 and 50
-        int latency = rand() % 10 + 1; // Random latency between 1 and 10
-        nodes[i] = new TreeNode(i, cost, latency);
+    // Worker threads are started before the timer so only partitioning is measured; they also generate the tree
+    std::unique_ptr<sasap::WorkStealingPool> pool;
+    if (partitioningThreads > 0) {
+        pool = std::make_unique<sasap::WorkStealingPool>(partitioningThreads);
     }
 
-    // Create random tree structure
-    for (int i = 1; i < N; ++i) {
-        int parent = rand() % i;
-        nodes[parent]->children.push_back(nodes[i]);
+    WorkflowTree tree;
+    if (N > 0) {
+        std::cout << "Seed: " << seed << std::endl;
+
+        // Create random tree structure with random costs (1 to 50) and latencies (1 to 10)
+        tree = sasap::generateTree(N, 0, {1, 50}, {1, 10}, seed, sasap::TreeShape::Random, pool.get());
+    } else {
+        try {
+            tree = sasap::loadWorkflow(input);
+        } catch (const std::runtime_error& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
     }
 
-    // Root node is nodes[0]
-    TreeNode* root = nodes[0];
-
     // Latency limit (example value)
     int latencyLimit = 20;
     // Cost limit (example value)
     int costLimit = 100;
 
     // Vector to store composite functions (partitions)
-    std::vector<std::unordered_set<int>> compositeFunctions;
+    CompositeFunctions compositeFunctions;
     double overallQoS = 0.0;
 
     auto start = std::chrono::high_resolution_clock::now();
     // Perform bicriteria approximation
-    bicriteriaApproximation(root, latencyLimit, costLimit, compositeFunctions, overallQoS);
+    bicriteriaApproximation(tree, latencyLimit, costLimit, options, compositeFunctions, overallQoS, pool.get());
     auto end = std::chrono::high_resolution_clock::now();
 
     // Calculate the duration
     std::chrono::duration<double> duration = end - start;
 
     // Calculate and print overall QoS satisfaction
-    int numPartitions = compositeFunctions.size();
-    overallQoS = (numPartitions > 0) ? overallQoS / numPartitions : 0.0;
+    std::size_t numPartitions = compositeFunctions.size();
     std::cout << "Overall QoS Satisfaction: " << overallQoS << "%" << std::endl;
 
+    std::cout << "Composite functions: " << numPartitions << " (epsilon " << options.epsilon
+              << ", cost scale " << compositeFunctions.costScale << ")" << std::endl;
+
     // Print composite functions
-    printCompositeFunctions(compositeFunctions, root);
+    printCompositeFunctions(compositeFunctions);
+
+    std::cout << "Execution time: " << duration.count() << " seconds." << std::endl;
+    std::cout << "Peak memory: " << sasap::peakResidentBytes() / (1024.0 * 1024.0) << " MB" << std::endl;
 
-    // Clean up memory
-    for (int i = 0; i < N; ++i) {
-        delete nodes[i];
+    std::string profile = sasap::writeProfileFromEnvironment();   // Only when SASAP_PROFILE names an output prefix
+    if (!profile.empty()) {
+        std::cout << "Profile: " << profile << ".profile.json, " << profile << ".trace.json" << std::endl;
     }
 
     return 0;
@@ -6,240 +6,270 @@
 
 */
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
 #include <vector>
-#include <queue>
-#include <unordered_map>
-#include <unordered_set>
-#include <thread>
-#include <mutex>
-#include <cstdlib>
-#include <ctime>
-#include <chrono>
-#include <openssl/evp.h>
-#include <openssl/aes.h>
-
-using namespace std;
-
-// Define a structure for tree nodes with a secure computation flag
-struct TreeNode {
-    int id;                       // Unique identifier for the node
-    int cost;                     // Cost associated with the node
-    int latency;                  // Latency associated with the node
-    bool secureComputation;       // Flag to indicate if secure computation is required
-    vector<TreeNode*> children;   // Vector of pointers to child nodes
-    TreeNode(int id, int cost, int latency, bool secure = false) 
-        : id(id), cost(cost), latency(latency), secureComputation(secure) {}
-};
-
-// Define a structure for partitions of nodes
-struct Partition {
-    int totalCost;                // Total cost of nodes in the partition
-    int totalLatency;             // Total latency of nodes in the partition
-    vector<int> nodes;            // Vector of node identifiers belonging to this partition
-    bool hasSecureNode;           // Flag to indicate if the partition contains secure nodes
-};
-
-// Define a structure to store inter-linkages between partitions
-struct Linkage {
-    int fromNode;
-    int toNode;
-};
-
-// Function to create a new partition containing a single node
-Partition createPartition(TreeNode* node) {
-    Partition partition = { node->cost, node->latency, {node->id}, node->secureComputation };
-    return partition;
-}
-
-// Function to partition the tree nodes based on latency and memory limits
-vector<Partition> improvedTreePartitioning(TreeNode* root, int latencyLimit, int memoryLimit, vector<Linkage>& linkages) {
-    vector<Partition> partitions;           // Vector to store all partitions
-    unordered_set<int> usedNodes;           // Set to track used node identifiers
-    queue<TreeNode*> q;                     // Queue for breadth-first traversal
-    q.push(root);                           // Start with the root node
-
-    // Traverse through the tree nodes
-    while (!q.empty()) {
-        TreeNode* node = q.front();
-        q.pop();
-
-        bool placed = false;
-
-        // Try to place the current node in an existing partition
-        for (auto& partition : partitions) {
-            if (partition.totalLatency + node->latency <= latencyLimit &&
-                partition.totalCost + node->cost <= memoryLimit &&
-                usedNodes.find(node->id) == usedNodes.end() &&
-                (!node->secureComputation || partition.hasSecureNode)) {
-                // Update the partition with the current node
-                partition.totalLatency += node->latency;
-                partition.totalCost += node->cost;
-                partition.nodes.push_back(node->id);
-                usedNodes.insert(node->id);
-                if (node->secureComputation) {
-                    partition.hasSecureNode = true;
-                }
-                placed = true;
-                break;
-            }
-        }
-
-        // If the node couldn't be placed in any existing partition, create a new partition
-        if (!placed) {
-            Partition new_partition = createPartition(node);
-            partitions.push_back(new_partition);
-            usedNodes.insert(node->id);
-        }
-
-        // Enqueue all children of the current node for further processing
-        for (auto child : node->children) {
-            if (usedNodes.find(child->id) == usedNodes.end()) {
-                linkages.push_back({node->id, child->id});  // Store inter-linkage
-                q.push(child);
-            }
-        }
-    }
-
-    return partitions;   // Return all partitions created
-}
-
-// Function to generate a random tree structure with given number of nodes and secure nodes
-TreeNode* generateTree(int numNodes, int secureNodeCount) {
-    vector<TreeNode*> nodes;   // Vector to store all tree nodes
-    vector<int> secureNodes;   // Vector to store indices of secure nodes
-
-    // Create nodes with random cost and latency
-    for (int i = 0; i < numNodes; ++i) {
-        bool secure = (i < secureNodeCount); // Assign secure computation flag to the first secureNodeCount nodes
-        nodes.push_back(new TreeNode(i, rand() % 20 + 1, rand() % 10 + 1, secure));
-        if (secure) {
-            secureNodes.push_back(i);
-        }
-    }
-
-    // Establish parent-child relationships to form a tree structure
-    for (int i = 1; i < numNodes; ++i) {
-        int parent = rand() % i;     // Randomly select a parent node index
-        nodes[parent]->children.push_back(nodes[i]);  // Add current node as a child of the selected parent
-    }
 
-    return nodes[0];   // Return the root node of the generated tree
-}
+#include "sasap/Arena.h"
+#include "sasap/CommunicationGraph.h"
+#include "sasap/DeploymentSimulator.h"
+#include "sasap/IncrementalPartitioning.h"
+#include "sasap/MemoryUsage.h"
+#include "sasap/MinimumPartitioning.h"
+#include "sasap/PlacementIndex.h"
+#include "sasap/Profiler.h"
+#include "sasap/Random.h"
+#include "sasap/SasapPartitioning.h"
+#include "sasap/SecureChannel.h"
+#include "sasap/WorkStealingPool.h"
+#include "sasap/WorkflowIO.h"
+#include "sasap/WorkflowTree.h"
 
-// Function to recursively delete all nodes of the tree to free memory
-void deleteTree(TreeNode* root) {
-    if (!root) return;
-    for (auto child : root->children) {
-        deleteTree(child);
-    }
-    delete root;
-}
+using namespace std;
+using sasap::Linkage;
+using sasap::LinkageList;
+using sasap::Partition;
+using sasap::PartitionList;
+using sasap::PlacementPolicy;
+using sasap::WorkStealingPool;
+using sasap::WorkflowTree;
 
 // Function to print all partitions and their respective node IDs
-void printPartitions(const vector<Partition>& partitions) {
+void printPartitions(const PartitionList& partitions) {
+    SASAP_PROFILE_SCOPE("output.print");
     for (size_t i = 0; i < partitions.size(); ++i) {
         cout << "Composite Function " << i + 1 << " : ";
         for (int nodeId : partitions[i].nodes) {
             cout << nodeId << " ";
         }
-        cout << (partitions[i].hasSecureNode ? " (Contains Secure Nodes)" : "") << endl;
+        cout << (partitions[i].hasSecureNode ? " (Contains Secure Nodes)" : "") << '\n';
     }
 }
 
 // Function to print inter-linkages between partitions
-void printLinkages(const vector<Linkage>& linkages) {
-    cout << "Inter-Linkages between partitions:" << endl;
+void printLinkages(const LinkageList& linkages) {
+    SASAP_PROFILE_SCOPE("output.print");
+    cout << "Inter-Linkages between partitions:" << '\n';
     for (const auto& linkage : linkages) {
-        cout << "Node " << linkage.fromNode << " -> Node " << linkage.toNode << endl;
+        cout << "Node " << linkage.fromNode << " -> Node " << linkage.toNode << '\n';
     }
 }
 
-// Function to encrypt data (dummy encryption for simulation)
-string encryptData(const string& data) {
-    return "encrypted(" + data + ")";
-}
-
-// Function to decrypt data (dummy decryption for simulation)
-string decryptData(const string& data) {
-    if (data.find("encrypted(") == 0 && data.back() == ')') {
-        return data.substr(10, data.size() - 11);  // Strip "encrypted(" and ")"
+// Function to format the first bytes of a buffer as hexadecimal
+string hexPrefix(const unsigned char* data, size_t count) {
+    static const char digits[] = "0123456789abcdef";
+    string text;
+    for (size_t i = 0; i < count; ++i) {
+        text += digits[data[i] >> 4];
+        text += digits[data[i] & 0xf];
     }
-    return data;
+    return text;
 }
 
-// Function to simulate partition deployment on vCPUs
-void deployPartitions(const vector<Partition>& partitions, const vector<Linkage>& linkages, int numVCPUs) {
-    vector<thread> vCPUs(numVCPUs);
-    mutex mtx;
-    int cpu = 0;
+// Largest workflow whose simulated deployment is traced event by event
+const int maxTracedNodes = 500;
+
+// Function to simulate partition deployment on vCPUs in virtual time. Partitions form a DAG
+// through the edges of their communication graph (cycles are collapsed into groups that run
+// as one task); a group starts on a free vCPU once all data it receives from other groups has
+// arrived, and transfers overlap with the execution of unrelated partitions. The payloads of
+// edges that carry secure linkages are sealed and opened on a real AES-256-GCM channel.
+void deployPartitions(const WorkflowTree& tree, const PartitionList& partitions, const sasap::CommunicationGraph& graph,
+                      int numVCPUs, bool traced) {
+    if (partitions.empty()) {
+        return;
+    }
+    sasap::DeploymentModel model;
+    model.vcpus = numVCPUs;
+    auto start = chrono::steady_clock::now();
+    sasap::DeploymentReport report = sasap::simulateDeployment(tree, partitions, graph, model, traced ? &cout : nullptr);
+    chrono::duration<double, milli> wall = chrono::steady_clock::now() - start;
+
+    // Seal the secure payloads in one batch, then open and authenticate every message
+    sasap::SecureChannel secureChannel;
+    sasap::MessageBatch batch;
+    for (int p = 0; p < graph.partitionCount(); ++p) {
+        for (int e = graph.firstEdge(p); e < graph.lastEdge(p); ++e) {
+            if (graph.secureLinkages[e] > 0) {
+                string data = "Data from partition " + to_string(p + 1) + " to partition " + to_string(graph.target[e] + 1)
+                            + " (" + to_string(graph.linkages[e]) + " linkages)";
+                batch.add(data.data(), data.size());
+            }
+        }
+    }
+    size_t failures = 0;
+    if (batch.size() > 0) {
+        secureChannel.sealBatch(batch);
+    }
+    for (size_t message = 0; message < batch.size(); ++message) {
+        string tag = hexPrefix(batch.tag(message), 4);
+        bool authentic = secureChannel.openMessage(batch, message);
+        failures += authentic ? 0 : 1;
+        if (traced) {
+            cout << "Secure communication: " << batch.length(message) << " bytes sealed (tag " << tag << "...) -> "
+                 << (authentic ? string(reinterpret_cast<const char*>(batch.payload(message)), batch.length(message)) : "authentication failed")
+                 << '\n';
+        }
+    }
 
-    auto executePartition = [&mtx](const Partition& partition, int cpu) {
-        for (int nodeId : partition.nodes) {
-            this_thread::sleep_for(chrono::milliseconds(100));
-            lock_guard<mutex> lock(mtx);
-            cout << "Executing node " << nodeId << " on partition on CPU " << cpu << endl;
+    const sasap::PartitionDag& dag = report.dag;
+    cout << "Dependency groups: " << dag.groupCount() << " (from " << partitions.size() << " partitions)" << endl;
+    cout << "Makespan: " << report.makespanMs << " ms virtual (serialized sum " << report.serialMs << " ms), "
+         << report.events << " events simulated in " << wall.count() << " ms" << endl;
+    // Long chains and large groups are shortened to their ends
+    const size_t shown = 8;
+    const vector<int>& chain = report.criticalGroups;
+    cout << "Critical path: " << report.criticalMs << " ms through " << chain.size() << " groups, partitions";
+    for (size_t k = 0; k < chain.size(); ++k) {
+        if (chain.size() > 2 * shown && k == shown) {
+            cout << " -> ...";
+            k = chain.size() - shown;
         }
-    };
-
-    auto secureCommunicate = [&mtx](const Linkage& linkage) {
-        this_thread::sleep_for(chrono::milliseconds(100)); // Simulate communication delay
-        lock_guard<mutex> lock(mtx);
-        string data = "Data from node " + to_string(linkage.fromNode) + " to node " + to_string(linkage.toNode);
-        string encryptedData = encryptData(data);
-        string decryptedData = decryptData(encryptedData);
-        cout << "Secure communication: " << encryptedData << " -> " << decryptedData << endl;
-    };
-
-    for (int i = 0; i < partitions.size(); ++i) {
-        if (i < numVCPUs) {
-            vCPUs[i] = thread(executePartition, partitions[i], cpu);
-            cpu = (cpu + 1) % numVCPUs;
-        } else {
-            vCPUs[i % numVCPUs].join();
-            vCPUs[i % numVCPUs] = thread(executePartition, partitions[i], cpu);
-            cpu = (cpu + 1) % numVCPUs;
+        int g = chain[k];
+        cout << (k == 0 ? " " : " -> ");
+        for (int i = dag.memberOffset[g]; i < min(dag.memberOffset[g + 1], dag.memberOffset[g] + static_cast<int>(shown)); ++i) {
+            cout << (i == dag.memberOffset[g] ? "" : "+") << dag.members[i] + 1;
         }
+        cout << (dag.memberOffset[g + 1] - dag.memberOffset[g] > static_cast<int>(shown) ? "+..." : "");
+    }
+    cout << endl;
+    cout << "vCPUs: " << numVCPUs << " at " << report.utilization * 100.0 << "% utilization, " << report.executions
+         << " invocations, " << report.coldStarts << " cold starts" << endl;
+    cout << "Transfers: " << report.transfers << ", " << report.bytes << " bytes (" << report.encryptedBytes << " encrypted)" << endl;
+
+    if (batch.size() == 0) {
+        cout << "Secure channel: no secure transfers" << endl;
+        return;
     }
+    sasap::CryptoStats crypto = secureChannel.stats();
+    cout << "Secure channel: " << crypto.messages << " messages, " << crypto.bytes << " bytes, "
+         << crypto.nanosecondsPerByte() << " ns/byte (" << crypto.nanoseconds / 1000.0 << " us in AES-256-GCM), "
+         << failures << " authentication failures" << endl;
+}
 
-    for (auto& vCPU : vCPUs) {
-        if (vCPU.joinable()) {
-            vCPU.join();
+// Function to replay profile drift: every round a thousandth of the functions get new cost and
+// latency profiles, and the partitions are repaired incrementally instead of being recomputed
+void simulateDrift(const WorkflowTree& tree, int latencyLimit, int memoryLimit, PlacementPolicy policy, int rounds, uint64_t seed) {
+    sasap::IncrementalPartitioner incremental(tree, latencyLimit, memoryLimit, policy);
+    int changesPerRound = max(1, tree.size() / 1000);
+    sasap::RandomStream random(seed, sasap::RandomStreamId::WorkflowDrift);
+
+    chrono::duration<double, milli> repairTime(0);
+    size_t placed = 0;
+    size_t touched = 0;
+    for (int round = 0; round < rounds; ++round) {
+        sasap::WorkflowDelta delta;
+        for (int i = 0; i < changesPerRound; ++i) {
+            int node = static_cast<int>(random.below(tree.size()));
+            int cost = random.uniform(1, 20);
+            int latency = random.uniform(1, 10);
+            delta.updates.push_back({ node, cost, latency, incremental.isSecure(node) });
         }
+        auto start = chrono::high_resolution_clock::now();
+        sasap::RepairStats stats = incremental.apply(delta);
+        repairTime += chrono::high_resolution_clock::now() - start;
+        placed += stats.nodesPlaced;
+        touched += stats.partitionsTouched;
     }
 
-    for (const auto& linkage : linkages) {
-        thread(secureCommunicate, linkage).join();
+    // A full run on the drifted workflow for comparison
+    vector<int> cost(tree.size()), latency(tree.size());
+    for (int node = 0; node < tree.size(); ++node) {
+        cost[node] = incremental.cost(node);
+        latency[node] = incremental.latency(node);
     }
+    WorkflowTree drifted = WorkflowTree::fromParents(cost, latency, tree.secureFlags(), tree.parents());
+    LinkageList linkages;
+    auto start = chrono::high_resolution_clock::now();
+    PartitionList full = sasap::improvedTreePartitioning(drifted, latencyLimit, memoryLimit, linkages, policy);
+    chrono::duration<double, milli> fullTime = chrono::high_resolution_clock::now() - start;
+
+    cout << "Drift: " << rounds << " rounds of " << changesPerRound << " updates, " << repairTime.count() / rounds
+         << " ms per incremental repair (" << placed / rounds << " nodes moved, " << touched / rounds
+         << " partitions touched) vs " << fullTime.count() << " ms for a full run" << endl;
+    cout << "Drift: " << incremental.partitionCount() << " partitions after repair vs " << full.size()
+         << " from a full run, constraints " << (incremental.satisfiesConstraints() ? "satisfied" : "VIOLATED") << endl;
 }
 
 // Main function to execute the program
 int main(int argc, char* argv[]) {
     // Validate command line arguments
-    if (argc != 4) {
-        cerr << "Usage: " << argv[0] << " <number_of_nodes> <number_of_vcpus> <number_of_secure_nodes>" << endl;
+    if (argc < 4 || argc > 8) {
+        cerr << "Usage: " << argv[0] << " <number_of_nodes|workflow_file> <number_of_vcpus> <number_of_secure_nodes>"
+             << " [first-fit|best-fit|worst-fit|locality|minimum] [partitioning_threads] [drift_rounds] [seed]" << endl;
         return 1;
     }
 
-    int numNodes = stoi(argv[1]);    // Number of nodes in the tree
+    // The first argument is either the number of nodes of a random tree or a workflow file,
+    // whose own secure flags then replace the secure node count
+    string input = argv[1];
+    int numNodes = sasap::isNodeCount(input) ? stoi(input) : 0;    // Number of nodes in the tree (0 for a file)
     int numVCPUs = stoi(argv[2]);    // Number of vCPUs
     int secureNodeCount = stoi(argv[3]);  // Number of nodes requiring secure computation
 
-    if (numNodes < 1 || numNodes > 500 || numVCPUs < 1 || secureNodeCount < 0 || secureNodeCount > numNodes) {
-        cerr << "Number of nodes must be between 1 and 500, number of vCPUs must be at least 1, and number of secure nodes must be between 0 and number of nodes." << endl;
+    PlacementPolicy policy = PlacementPolicy::FirstFit;   // Rule for choosing among fitting partitions
+    bool locality = argc >= 5 && string(argv[4]) == "locality";   // Keep parents and children together instead
+    bool minimum = argc >= 5 && string(argv[4]) == "minimum";     // Fewest connected partitions under SASAP's secure rule
+    if (argc >= 5 && !locality && !minimum) {
+        try {
+            policy = sasap::parsePlacementPolicy(argv[4]);
+        } catch (const invalid_argument& e) {
+            cerr << e.what() << endl;
+            return 1;
+        }
+    }
+    int partitioningThreads = argc >= 6 ? stoi(argv[5]) : 0;   // 0 partitions on the calling thread
+    int driftRounds = argc >= 7 ? stoi(argv[6]) : 0;           // Rounds of incremental re-partitioning to replay
+    uint64_t seed = argc == 8 ? stoull(argv[7]) : sasap::freshSeed();   // Seed of the generated tree and the drift
+
+    if ((sasap::isNodeCount(input) && (numNodes < 1 || secureNodeCount > numNodes)) || numVCPUs < 1 || secureNodeCount < 0 || partitioningThreads < 0 || driftRounds < 0) {
+        cerr << "Number of nodes must be at least 1, number of vCPUs must be at least 1, and number of secure nodes must be between 0 and number of nodes." << endl;
         return 1;
     }
 
-    srand(time(0));   // Seed the random number generator
+    // Worker threads are started before the timer so only partitioning is measured; they also generate the tree
+    unique_ptr<WorkStealingPool> pool;
+    if (partitioningThreads > 0) {
+        pool = make_unique<WorkStealingPool>(partitioningThreads);
+    }
 
-    TreeNode* root = generateTree(numNodes, secureNodeCount);   // Generate a random tree with specified number of nodes
+    WorkflowTree tree;
+    if (numNodes > 0) {
+        cout << "Seed: " << seed << endl;
+        tree = sasap::generateTree(numNodes, secureNodeCount, {1, 20}, {1, 10}, seed, sasap::TreeShape::Random, pool.get());   // Generate a random tree with specified number of nodes
+    } else {
+        try {
+            tree = sasap::loadWorkflow(input);
+        } catch (const runtime_error& e) {
+            cerr << e.what() << endl;
+            return 1;
+        }
+        numNodes = tree.size();
+    }
 
     int latencyLimit = 50;    // Adjusted latency limit for more partitions
     int memoryLimit = 100;    // Adjusted memory limit for more partitions
 
-    vector<Linkage> linkages;    // Vector to store inter-linkages
+    // Partitions, their member lists and the linkages of the run all live in one arena
+    sasap::Arena arena;
+    LinkageList linkages(&arena);    // Vector to store inter-linkages
     auto start = chrono::high_resolution_clock::now();
-    vector<Partition> partitions = improvedTreePartitioning(root, latencyLimit, memoryLimit, linkages);   // Partition the tree nodes
+    PartitionList partitions(&arena);
+    if (locality) {
+        partitions = sasap::localityTreePartitioning(tree, latencyLimit, memoryLimit, linkages, sasap::LocalityOptions(), &arena);   // Emits only inter-partition linkages
+    } else if (minimum) {
+        partitions = sasap::minimumTreePartitioning(tree, latencyLimit, memoryLimit, linkages, true, &arena);   // Cuts the heaviest children first
+    } else if (partitioningThreads > 0) {
+        partitions = sasap::parallelTreePartitioning(tree, latencyLimit, memoryLimit, linkages, policy, *pool, 256, &arena);   // Partition subtrees concurrently
+    } else {
+        partitions = sasap::improvedTreePartitioning(tree, latencyLimit, memoryLimit, linkages, policy, &arena);   // Partition the tree nodes
+    }
     auto end = chrono::high_resolution_clock::now();
     chrono::duration<double> duration = end - start;
 
@@ -248,17 +278,18 @@ int main(int argc, char* argv[]) {
         partition.totalCost = 0;
         partition.totalLatency = 0;
         for (int nodeId : partition.nodes) {
-            partition.totalCost += abs(root[nodeId].cost % 100 );        // Sum up the costs of nodes in the partition
-            partition.totalLatency += abs(root[nodeId].latency % 100);  // Sum up the latencies of nodes in the partition
+            partition.totalCost += abs(tree.cost(nodeId) % 100);        // Sum up the costs of nodes in the partition
+            partition.totalLatency += abs(tree.latency(nodeId) % 100);  // Sum up the latencies of nodes in the partition
         }
     }
 
     // Find the best partition based on total cost and total latency
-    Partition best_partition = partitions[0];
-    for (const auto& partition : partitions) {
-        if (partition.totalCost < best_partition.totalCost ||
-            (partition.totalCost == best_partition.totalCost && partition.totalLatency < best_partition.totalLatency)) {
-            best_partition = partition;
+    size_t best_partition = 0;   // Index rather than a copy, so large partitions are not duplicated
+    for (size_t i = 1; i < partitions.size(); ++i) {
+        const Partition& partition = partitions[i];
+        if (partition.totalCost < partitions[best_partition].totalCost ||
+            (partition.totalCost == partitions[best_partition].totalCost && partition.totalLatency < partitions[best_partition].totalLatency)) {
+            best_partition = i;
         }
     }
 
@@ -271,10 +302,37 @@ int main(int argc, char* argv[]) {
 
     cout << "Execution time: " << duration.count() << " seconds." << endl;
 
-    // Simulate deployment on vCPUs and secure communication between partitions
-    deployPartitions(partitions, linkages, numVCPUs);
+    // Aggregate the linkages into one edge per pair of communicating partitions
+    sasap::CommunicationGraph graph = sasap::buildCommunicationGraph(tree, partitions, linkages);
+    sasap::CommunicationTotals traffic = sasap::communicationTotals(graph);
+    cout << "Communication graph: " << traffic.edges << " partition pairs, " << traffic.linkages << " linkages ("
+         << traffic.secureLinkages << " secure), " << traffic.bytes << " bytes (" << traffic.secureBytes << " on secure channels)" << endl;
+    if (locality) {
+        cout << "Locality: " << linkages.size() << " inter-partition linkages, weighted communication cost "
+             << sasap::communicationCost(tree, linkages, sasap::LocalityOptions().secureEdgeWeight) << endl;
+    }
+    if (minimum) {
+        size_t lowerBound = sasap::minimumPartitionLowerBound(tree, latencyLimit, memoryLimit);
+        cout << "Minimum: " << partitions.size() << " connected partitions, lower bound " << lowerBound
+             << (partitions.size() == lowerBound ? " (optimal)" : "") << endl;
+    }
+    cout << "Peak memory: " << sasap::peakResidentBytes() / (1024.0 * 1024.0) << " MB" << endl;
+    const sasap::ArenaStats& arenaStats = arena.stats();
+    cout << "Arena: " << arenaStats.allocations << " allocations, " << arenaStats.bytesAllocated / (1024.0 * 1024.0)
+         << " MB allocated in " << arenaStats.chunks << " chunks (" << arenaStats.bytesReserved / (1024.0 * 1024.0) << " MB reserved)" << endl;
+
+    if (driftRounds > 0) {
+        simulateDrift(tree, latencyLimit, memoryLimit, policy, driftRounds, seed);
+    }
+
+    // Simulate deployment on vCPUs and secure communication between partitions. The simulation
+    // runs in virtual time, so it covers workflows of any size; small ones are traced in full.
+    deployPartitions(tree, partitions, graph, numVCPUs, numNodes <= maxTracedNodes);
 
-    deleteTree(root);   // Delete the tree nodes to free memory
+    string profile = sasap::writeProfileFromEnvironment();   // Only when SASAP_PROFILE names an output prefix
+    if (!profile.empty()) {
+        cout << "Profile: " << profile << ".profile.json, " << profile << ".trace.json" << endl;
+    }
 
     return 0;   // Exit the program
 }
\ No newline at end of file
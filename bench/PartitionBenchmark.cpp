@@ -0,0 +1,407 @@
+/*
+
+   Benchmark harness comparing SASAP, GrTP, LRTP and BiFPTAS on the same workflow trees.
+   Every combination of node count, tree shape, secure-node ratio, limits and seed is run
+   with a fixed seed, repeated, and reported as one CSV row or JSON object holding the
+   median and percentile wall time, the number of composite functions created and the mean
+   QoS satisfaction, plus the peak resident memory while the algorithm ran (the shared tree
+   included). The output is what the benchmark cells of Illustrations.ipynb plot.
+
+   Example:
+     ./partition_benchmark --nodes 1000,10000,100000 --shapes random,binary --secure-ratios 0,0.2
+                           --repeats 7 --format csv --output bench_results.csv
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../sasap/Arena.h"
+#include "../sasap/BicriteriaFptas.h"
+#include "../sasap/GreedyPartitioning.h"
+#include "../sasap/LeftRightTraversal.h"
+#include "../sasap/MemoryUsage.h"
+#include "../sasap/MinimumPartitioning.h"
+#include "../sasap/PlacementIndex.h"
+#include "../sasap/Profiler.h"
+#include "../sasap/QoS.h"
+#include "../sasap/SasapPartitioning.h"
+#include "../sasap/WorkStealingPool.h"
+#include "../sasap/WorkflowTree.h"
+
+using namespace std;
+using sasap::WorkflowTree;
+
+// Parameters of one benchmark sweep
+struct BenchmarkConfig {
+    vector<string> algorithms = { "sasap", "grtp", "lrtp", "bif" };
+    vector<int> nodeCounts = { 100, 1000, 10000, 100000 };
+    vector<sasap::TreeShape> shapes = { sasap::TreeShape::Random, sasap::TreeShape::Binary };
+    vector<double> secureRatios = { 0.0, 0.2 };
+    vector<int> latencyLimits = { 50 };
+    vector<int> costLimits = { 100 };
+    vector<unsigned> seeds = { 42 };
+    sasap::WeightRange cost = { 1, 20 };
+    sasap::WeightRange latency = { 1, 10 };
+    sasap::PlacementPolicy policy = sasap::PlacementPolicy::FirstFit;
+    double epsilon = 0.1;
+    int repeats = 5;
+    int warmups = 1;
+    int threads = 0;        // 0 runs every partitioner on the calling thread
+    string format = "csv";
+    string output;          // Empty writes to standard output
+};
+
+// Outcome of one algorithm on one configuration
+struct BenchmarkRow {
+    string algorithm;
+    sasap::TreeShape shape;
+    int nodes;
+    double secureRatio;
+    int latencyLimit;
+    int costLimit;
+    unsigned seed;
+    size_t partitions;
+    double qos;
+    double peakMegabytes;    // Peak resident memory of the process during the runs
+    vector<double> millis;   // Wall time of every timed repetition, sorted
+};
+
+// Composite functions reduced to what the report needs
+struct RunSummary {
+    size_t partitions = 0;
+    double qos = 0.0;
+};
+
+// Function to split a comma separated list
+vector<string> splitList(const string& text) {
+    vector<string> items;
+    stringstream stream(text);
+    string item;
+    while (getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+template <typename T, typename Parse>
+vector<T> parseList(const string& text, Parse parse) {
+    vector<T> values;
+    for (const string& item : splitList(text)) {
+        values.push_back(parse(item));
+    }
+    if (values.empty()) {
+        throw invalid_argument("empty list: " + text);
+    }
+    return values;
+}
+
+// Function to parse "min:max"
+sasap::WeightRange parseRange(const string& text) {
+    size_t colon = text.find(':');
+    if (colon == string::npos) {
+        throw invalid_argument("expected min:max, got " + text);
+    }
+    sasap::WeightRange range = { stoi(text.substr(0, colon)), stoi(text.substr(colon + 1)) };
+    if (range.min > range.max) {
+        throw invalid_argument("empty range: " + text);
+    }
+    return range;
+}
+
+void printUsage(const char* program) {
+    cerr << "Usage: " << program << " [options]\n"
+         << "  --algorithms LIST      sasap,sasap-locality,sasap-minimum,grtp,lrtp,bif\n"
+         << "                         (default sasap,grtp,lrtp,bif)\n"
+         << "  --nodes LIST           node counts (default 100,1000,10000,100000)\n"
+         << "  --shapes LIST          random,chain,star,binary,kary,caterpillar,\n"
+         << "                         powerlaw (default random,binary)\n"
+         << "  --secure-ratios LIST   fraction of secure nodes (default 0,0.2)\n"
+         << "  --latency-limits LIST  latency limits (default 50)\n"
+         << "  --cost-limits LIST     cost limits (default 100)\n"
+         << "  --seeds LIST           tree generator seeds (default 42)\n"
+         << "  --cost MIN:MAX         node cost range (default 1:20)\n"
+         << "  --latency MIN:MAX      node latency range (default 1:10)\n"
+         << "  --policy NAME          SASAP placement: first-fit|best-fit|worst-fit\n"
+         << "  --epsilon E            BiFPTAS cost relaxation (default 0.1)\n"
+         << "  --repeats N            timed repetitions (default 5)\n"
+         << "  --warmups N            untimed repetitions (default 1)\n"
+         << "  --threads N            partitioning threads, 0 = serial (default 0)\n"
+         << "  --format csv|json      output format (default csv)\n"
+         << "  --output PATH          output file (default standard output)" << endl;
+}
+
+// Function to read the command line into a sweep configuration
+BenchmarkConfig parseArguments(int argc, char* argv[]) {
+    BenchmarkConfig config;
+    for (int i = 1; i < argc; i += 2) {
+        string key = argv[i];
+        if (i + 1 >= argc) {
+            throw invalid_argument("missing value for " + key);
+        }
+        string value = argv[i + 1];
+        if (key == "--algorithms") {
+            config.algorithms = parseList<string>(value, [](const string& s) {
+                if (s != "sasap" && s != "sasap-locality" && s != "sasap-minimum" && s != "grtp" && s != "lrtp" && s != "bif") {
+                    throw invalid_argument("unknown algorithm: " + s);
+                }
+                return s;
+            });
+        } else if (key == "--nodes") {
+            config.nodeCounts = parseList<int>(value, [](const string& s) { return stoi(s); });
+        } else if (key == "--shapes") {
+            config.shapes = parseList<sasap::TreeShape>(value, sasap::parseTreeShape);
+        } else if (key == "--secure-ratios") {
+            config.secureRatios = parseList<double>(value, [](const string& s) { return stod(s); });
+        } else if (key == "--latency-limits") {
+            config.latencyLimits = parseList<int>(value, [](const string& s) { return stoi(s); });
+        } else if (key == "--cost-limits") {
+            config.costLimits = parseList<int>(value, [](const string& s) { return stoi(s); });
+        } else if (key == "--seeds") {
+            config.seeds = parseList<unsigned>(value, [](const string& s) { return static_cast<unsigned>(stoul(s)); });
+        } else if (key == "--cost") {
+            config.cost = parseRange(value);
+        } else if (key == "--latency") {
+            config.latency = parseRange(value);
+        } else if (key == "--policy") {
+            config.policy = sasap::parsePlacementPolicy(value);
+        } else if (key == "--epsilon") {
+            config.epsilon = stod(value);
+        } else if (key == "--repeats") {
+            config.repeats = stoi(value);
+        } else if (key == "--warmups") {
+            config.warmups = stoi(value);
+        } else if (key == "--threads") {
+            config.threads = stoi(value);
+        } else if (key == "--format") {
+            config.format = value;
+        } else if (key == "--output") {
+            config.output = value;
+        } else {
+            throw invalid_argument("unknown option: " + key);
+        }
+    }
+
+    if (config.repeats < 1 || config.warmups < 0 || config.threads < 0 || !(config.epsilon > 0.0)
+        || (config.format != "csv" && config.format != "json")) {
+        throw invalid_argument("repeats must be at least 1, warmups and threads non-negative, epsilon positive "
+                               "and format csv or json");
+    }
+    for (int n : config.nodeCounts) {
+        if (n < 1) {
+            throw invalid_argument("node counts must be positive");
+        }
+    }
+    for (double ratio : config.secureRatios) {
+        if (ratio < 0.0 || ratio > 1.0) {
+            throw invalid_argument("secure ratios must be between 0 and 1");
+        }
+    }
+    for (int limit : config.latencyLimits) {
+        if (limit < 1) {
+            throw invalid_argument("latency limits must be positive");
+        }
+    }
+    for (int limit : config.costLimits) {
+        if (limit < 1) {
+            throw invalid_argument("cost limits must be positive");
+        }
+    }
+    return config;
+}
+
+// Function to run one partitioner once and summarise its composite functions
+RunSummary runAlgorithm(const string& algorithm, const WorkflowTree& tree, int latencyLimit, int costLimit,
+                        const BenchmarkConfig& config, sasap::WorkStealingPool* pool, sasap::Arena& arena) {
+    RunSummary summary;
+    if (algorithm == "sasap" || algorithm == "sasap-locality" || algorithm == "sasap-minimum") {
+        sasap::LinkageList linkages(&arena);
+        sasap::PartitionList partitions(&arena);
+        if (algorithm == "sasap-locality") {
+            sasap::LocalityOptions options;
+            options.policy = config.policy;
+            partitions = sasap::localityTreePartitioning(tree, latencyLimit, costLimit, linkages, options, &arena);
+        } else if (algorithm == "sasap-minimum") {
+            partitions = sasap::minimumTreePartitioning(tree, latencyLimit, costLimit, linkages, true, &arena);
+        } else if (pool) {
+            partitions = sasap::parallelTreePartitioning(tree, latencyLimit, costLimit, linkages, config.policy, *pool, 256, &arena);
+        } else {
+            partitions = sasap::improvedTreePartitioning(tree, latencyLimit, costLimit, linkages, config.policy, &arena);
+        }
+        vector<int64_t> totalCost(partitions.size()), totalLatency(partitions.size());
+        for (size_t f = 0; f < partitions.size(); ++f) {
+            totalCost[f] = partitions[f].totalCost;
+            totalLatency[f] = partitions[f].totalLatency;
+        }
+        summary.partitions = partitions.size();
+        summary.qos = sasap::evaluateQoS(totalCost.data(), totalLatency.data(), partitions.size(), costLimit, latencyLimit);
+    } else if (algorithm == "grtp") {
+        sasap::GreedyPartitions partitions = pool ? sasap::parallelGreedyTreePartitioning(tree, latencyLimit, costLimit, *pool, 256, &arena)
+                                                  : sasap::greedyTreePartitioning(tree, latencyLimit, costLimit, &arena);
+        vector<int64_t> totalCost(partitions.size(), 0), totalLatency(partitions.size(), 0);
+        for (size_t f = 0; f < partitions.size(); ++f) {
+            for (int node : partitions[f]) {
+                totalCost[f] += tree.cost(node);
+                totalLatency[f] += tree.latency(node);
+            }
+        }
+        summary.partitions = partitions.size();
+        summary.qos = sasap::evaluateQoS(totalCost.data(), totalLatency.data(), partitions.size(), costLimit, latencyLimit);
+    } else if (algorithm == "lrtp") {
+        sasap::LeftRightResult functions = sasap::leftRightPartition(tree, costLimit, latencyLimit);
+        summary.partitions = functions.size();
+        summary.qos = functions.overallQoS;
+    } else {
+        sasap::BicriteriaOptions options;
+        options.epsilon = config.epsilon;
+        sasap::BicriteriaResult functions = pool ? sasap::bicriteriaPartition(tree, latencyLimit, costLimit, options, *pool)
+                                                 : sasap::bicriteriaPartition(tree, latencyLimit, costLimit, options);
+        summary.partitions = functions.size();
+        summary.qos = sasap::evaluateQoS(functions.totalCost.data(), functions.totalLatency.data(), functions.size(), costLimit, latencyLimit);
+    }
+    return summary;
+}
+
+// Function to return the nearest-rank percentile of sorted samples
+double percentile(const vector<double>& sorted, double p) {
+    size_t rank = static_cast<size_t>(p / 100.0 * sorted.size() + 0.999999);
+    rank = min(max<size_t>(rank, 1), sorted.size());
+    return sorted[rank - 1];
+}
+
+// Function to return the median of sorted samples
+double median(const vector<double>& sorted) {
+    size_t n = sorted.size();
+    return n % 2 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+}
+
+void writeCsv(ostream& out, const vector<BenchmarkRow>& rows, const BenchmarkConfig& config) {
+    out << "algorithm,shape,nodes,secure_ratio,latency_limit,cost_limit,seed,threads,repeats,"
+           "partitions,qos,median_ms,p10_ms,p90_ms,p99_ms,min_ms,max_ms,peak_rss_mb\n";
+    for (const BenchmarkRow& row : rows) {
+        out << row.algorithm << ',' << sasap::treeShapeName(row.shape) << ',' << row.nodes << ',' << row.secureRatio << ','
+            << row.latencyLimit << ',' << row.costLimit << ',' << row.seed << ',' << config.threads << ','
+            << row.millis.size() << ',' << row.partitions << ',' << row.qos << ',' << median(row.millis) << ','
+            << percentile(row.millis, 10) << ',' << percentile(row.millis, 90) << ',' << percentile(row.millis, 99) << ','
+            << row.millis.front() << ',' << row.millis.back() << ',' << row.peakMegabytes << '\n';
+    }
+}
+
+void writeJson(ostream& out, const vector<BenchmarkRow>& rows, const BenchmarkConfig& config) {
+    out << "[\n";
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const BenchmarkRow& row = rows[i];
+        out << "  {\"algorithm\": \"" << row.algorithm << "\", \"shape\": \"" << sasap::treeShapeName(row.shape)
+            << "\", \"nodes\": " << row.nodes << ", \"secure_ratio\": " << row.secureRatio
+            << ", \"latency_limit\": " << row.latencyLimit << ", \"cost_limit\": " << row.costLimit
+            << ", \"seed\": " << row.seed << ", \"threads\": " << config.threads << ", \"repeats\": " << row.millis.size()
+            << ", \"partitions\": " << row.partitions << ", \"qos\": " << row.qos
+            << ", \"median_ms\": " << median(row.millis) << ", \"p10_ms\": " << percentile(row.millis, 10)
+            << ", \"p90_ms\": " << percentile(row.millis, 90) << ", \"p99_ms\": " << percentile(row.millis, 99)
+            << ", \"min_ms\": " << row.millis.front() << ", \"max_ms\": " << row.millis.back()
+            << ", \"peak_rss_mb\": " << row.peakMegabytes << ", \"samples_ms\": [";
+        for (size_t k = 0; k < row.millis.size(); ++k) {
+            out << (k ? ", " : "") << row.millis[k];
+        }
+        out << "]}" << (i + 1 < rows.size() ? "," : "") << '\n';
+    }
+    out << "]\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 2 && (string(argv[1]) == "--help" || string(argv[1]) == "-h")) {
+        printUsage(argv[0]);
+        return 0;
+    }
+
+    BenchmarkConfig config;
+    try {
+        config = parseArguments(argc, argv);
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // Worker threads are started once, outside every timed region
+    unique_ptr<sasap::WorkStealingPool> pool;
+    if (config.threads > 0) {
+        pool = make_unique<sasap::WorkStealingPool>(config.threads);
+    }
+    sasap::Arena arena;   // Reused by every run, so repeats do not churn the heap
+
+    vector<BenchmarkRow> rows;
+    for (sasap::TreeShape shape : config.shapes) {
+        for (int nodes : config.nodeCounts) {
+            for (double ratio : config.secureRatios) {
+                for (unsigned seed : config.seeds) {
+                    // The same seeded tree is shared by every algorithm and limit
+                    int secureNodeCount = static_cast<int>(ratio * nodes + 0.5);
+                    WorkflowTree tree = sasap::generateTree(nodes, secureNodeCount, config.cost, config.latency, seed, shape, pool.get());
+
+                    for (int latencyLimit : config.latencyLimits) {
+                        for (int costLimit : config.costLimits) {
+                            for (const string& algorithm : config.algorithms) {
+                                BenchmarkRow row = { algorithm, shape, nodes, ratio, latencyLimit, costLimit, seed, 0, 0.0, 0.0, {} };
+                                RunSummary summary;
+                                // Where supported, the peak restarts here so earlier (larger) runs do not mask this one
+                                sasap::resetPeakResident();
+                                for (int run = 0; run < config.warmups + config.repeats; ++run) {
+                                    // Each run starts from an empty arena that already holds the previous run's footprint
+                                    arena.reset();
+                                    auto start = chrono::steady_clock::now();
+                                    summary = runAlgorithm(algorithm, tree, latencyLimit, costLimit, config, pool.get(), arena);
+                                    chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+                                    if (run >= config.warmups) {
+                                        row.millis.push_back(elapsed.count());
+                                    }
+                                }
+                                sort(row.millis.begin(), row.millis.end());
+                                row.partitions = summary.partitions;
+                                row.qos = summary.qos;
+                                row.peakMegabytes = sasap::peakResidentBytes() / (1024.0 * 1024.0);
+                                rows.push_back(row);
+                                cerr << algorithm << " " << sasap::treeShapeName(shape) << " n=" << nodes << " secure=" << ratio
+                                     << " L=" << latencyLimit << " C=" << costLimit << " seed=" << seed << ": "
+                                     << median(row.millis) << " ms median" << endl;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    ofstream file;
+    if (!config.output.empty()) {
+        file.open(config.output);
+        if (!file) {
+            cerr << "Cannot open " << config.output << endl;
+            return 1;
+        }
+    }
+    ostream& out = config.output.empty() ? cout : file;
+    if (config.format == "csv") {
+        writeCsv(out, rows, config);
+    } else {
+        writeJson(out, rows, config);
+    }
+
+    // Reported on stderr, which keeps the CSV or JSON on stdout clean
+    string profile = sasap::writeProfileFromEnvironment();
+    if (!profile.empty()) {
+        cerr << "Profile: " << profile << ".profile.json, " << profile << ".trace.json" << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include "Arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace sasap {
+
+namespace {
+
+constexpr std::size_t kHeaderBytes = (sizeof(void*) + sizeof(std::size_t) + alignof(std::max_align_t) - 1)
+                                     / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+} // namespace
+
+// Function to create an empty arena whose first chunk holds at least chunkBytes
+Arena::Arena(std::size_t chunkBytes, std::pmr::memory_resource* upstream)
+    : upstream_(upstream), nextChunkBytes_(std::max<std::size_t>(chunkBytes, 4096)) {}
+
+Arena::~Arena() {
+    releaseChunks();
+}
+
+// Function to obtain a chunk of at least bytes usable bytes from upstream
+void Arena::addChunk(std::size_t bytes) {
+    std::size_t size = std::max(bytes, nextChunkBytes_);
+    void* memory = upstream_->allocate(kHeaderBytes + size, alignof(std::max_align_t));
+    Chunk* chunk = static_cast<Chunk*>(memory);
+    chunk->next = chunks_;
+    chunk->size = size;
+    chunks_ = chunk;
+    cursor_ = static_cast<char*>(memory) + kHeaderBytes;
+    limit_ = cursor_ + size;
+    nextChunkBytes_ = size * 2;   // Geometric growth keeps the chunk count logarithmic
+    stats_.bytesReserved += size;
+    ++stats_.chunks;
+    ++stats_.upstreamAllocations;
+}
+
+void Arena::releaseChunks() {
+    while (chunks_ != nullptr) {
+        Chunk* next = chunks_->next;
+        upstream_->deallocate(chunks_, kHeaderBytes + chunks_->size, alignof(std::max_align_t));
+        chunks_ = next;
+    }
+    cursor_ = limit_ = nullptr;
+    stats_.bytesReserved = 0;
+    stats_.chunks = 0;
+}
+
+// Function to return the size class of a small block, or kSizeClasses for large ones
+std::size_t Arena::sizeClass(std::size_t bytes, std::size_t alignment) {
+    if (alignment > alignof(std::max_align_t)) {
+        return kSizeClasses;
+    }
+    std::size_t size = kMinClassBytes;
+    std::size_t index = 0;
+    while (size < bytes && index < kSizeClasses) {
+        size *= 2;
+        ++index;
+    }
+    return index;
+}
+
+// Function to release every allocation at once, keeping one chunk large enough for all of them
+void Arena::reset() {
+    freeLists_.fill(nullptr);
+    if (stats_.chunks > 1) {
+        // Coalesce: the next run of the same size is served from a single chunk
+        std::size_t total = stats_.bytesReserved;
+        releaseChunks();
+        nextChunkBytes_ = total;
+        addChunk(total);
+    } else if (chunks_ != nullptr) {
+        cursor_ = reinterpret_cast<char*>(chunks_) + kHeaderBytes;
+    }
+    stats_.allocations = 0;
+    stats_.bytesAllocated = 0;
+    stats_.recycled = 0;
+}
+
+void* Arena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    std::size_t index = sizeClass(bytes, alignment);
+    if (index < kSizeClasses) {
+        bytes = kMinClassBytes << index;
+        alignment = std::min(bytes, alignof(std::max_align_t));
+        if (void* block = freeLists_[index]) {
+            freeLists_[index] = *static_cast<void**>(block);
+            ++stats_.allocations;
+            ++stats_.recycled;
+            stats_.bytesAllocated += bytes;
+            return block;
+        }
+    }
+
+    auto aligned = [&]() {
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(cursor_);
+        return reinterpret_cast<char*>((address + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1));
+    };
+    char* p = cursor_ != nullptr ? aligned() : nullptr;
+    if (p == nullptr || p + bytes > limit_) {
+        addChunk(bytes + alignment);
+        p = aligned();
+    }
+    cursor_ = p + bytes;
+    ++stats_.allocations;
+    stats_.bytesAllocated += bytes;
+    return p;
+}
+
+// Small blocks go back onto their free list; larger ones are only reclaimed by reset()
+void Arena::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    std::size_t index = sizeClass(bytes, alignment);
+    if (index < kSizeClasses) {
+        *static_cast<void**>(p) = freeLists_[index];
+        freeLists_[index] = p;
+    }
+}
+
+bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+} // namespace sasap
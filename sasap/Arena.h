@@ -0,0 +1,80 @@
+/*
+
+   Arena allocator for the lifetime of one partitioning run. Allocations are carved from
+   large chunks by bumping a pointer and reset() drops everything at once. Small blocks are
+   rounded up to power-of-two size classes, and a freed small block (typically the old
+   buffer of a member list that grew) goes onto a free list for its class and is handed out
+   again; larger blocks are only reclaimed by reset(). After a run that needed several
+   chunks, reset() replaces them with a single chunk of their combined size, so a loop of
+   similar runs settles into one contiguous region instead of fragmenting the heap. The
+   arena is a std::pmr::memory_resource, so pmr containers allocate from it directly. It is
+   not thread-safe: concurrent tasks use their own arenas.
+
+*/
+
+#ifndef SASAP_ARENA_H
+#define SASAP_ARENA_H
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+
+namespace sasap {
+
+// Allocation statistics of an arena
+struct ArenaStats {
+    std::size_t allocations = 0;            // Allocations served since the last reset
+    std::size_t bytesAllocated = 0;         // Bytes handed out since the last reset (after size-class rounding)
+    std::size_t recycled = 0;               // Allocations served from a free list since the last reset
+    std::size_t bytesReserved = 0;          // Bytes currently held in chunks
+    std::size_t chunks = 0;                 // Chunks currently held
+    std::size_t upstreamAllocations = 0;    // Chunks obtained from the upstream resource over the arena's lifetime
+};
+
+class Arena : public std::pmr::memory_resource {
+public:
+    // Function to create an empty arena whose first chunk holds at least chunkBytes
+    explicit Arena(std::size_t chunkBytes = 1 << 20,
+                   std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~Arena() override;
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Function to release every allocation at once, keeping one chunk large enough for all of them
+    void reset();
+
+    const ArenaStats& stats() const { return stats_; }
+
+private:
+    struct Chunk {
+        Chunk* next;
+        std::size_t size;    // Usable bytes following the header
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    // Function to obtain a chunk of at least bytes usable bytes from upstream
+    void addChunk(std::size_t bytes);
+    void releaseChunks();
+
+    static constexpr std::size_t kMinClassBytes = 16;
+    static constexpr std::size_t kSizeClasses = 7;    // 16 .. 1024 bytes
+
+    // Function to return the size class of a small block, or kSizeClasses for large ones
+    static std::size_t sizeClass(std::size_t bytes, std::size_t alignment);
+
+    std::pmr::memory_resource* upstream_;
+    std::size_t nextChunkBytes_;
+    Chunk* chunks_ = nullptr;    // Most recent chunk first
+    char* cursor_ = nullptr;     // Next free byte of the current chunk
+    char* limit_ = nullptr;      // End of the current chunk
+    std::array<void*, kSizeClasses> freeLists_{};   // Freed small blocks, linked through their first word
+    ArenaStats stats_;
+};
+
+} // namespace sasap
+
+#endif // SASAP_ARENA_H
@@ -0,0 +1,356 @@
+#include "BicriteriaFptas.h"
+
+#include "Profiler.h"
+#include "SubtreeSplit.h"
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <utility>
+
+namespace sasap {
+
+namespace {
+
+// DP state of the composite function still open at a node
+struct State {
+    int closed;    // Composite functions already closed in the processed part of the subtree
+    int cost;      // Scaled cost of the open composite function
+    int latency;   // Latency of the open composite function
+};
+
+// How a state was derived from the previous DP step
+struct Provenance {
+    int prev;         // Index of the extended state in the previous step
+    int childState;   // Index of the merged child state (-1 when the edge to the child is cut)
+};
+
+struct Candidate {
+    State state;
+    Provenance from;
+};
+
+// Limits of one open composite function, in scaled units
+struct Bounds {
+    int cost;
+    int latency;
+    std::size_t maxFrontier;
+};
+
+// Function to combine the states of a node with the final states of one of its children.
+// Every current state either cuts the child off (closing the child's function) or merges
+// one of the child's states into the open function. Dominated states are pruned in
+// (closed, cost, latency), and states that can no longer reach the minimum closed count
+// once the remaining children are handled are dropped.
+void mergeChild(const std::vector<State>& current, const State* child, int childCount, int remainingChildren,
+                const Bounds& bounds, std::vector<Candidate>& scratch, std::vector<State>& next,
+                std::vector<Provenance>* provenance, std::size_t& cappedSteps) {
+    scratch.clear();
+    const int childClosed = child[0].closed;
+    for (int i = 0; i < static_cast<int>(current.size()); ++i) {
+        const State& s = current[i];
+        scratch.push_back({ { s.closed + childClosed + 1, s.cost, s.latency }, { i, -1 } });
+        for (int j = 0; j < childCount; ++j) {
+            int cost = s.cost + child[j].cost;
+            int latency = s.latency + child[j].latency;
+            if (cost <= bounds.cost && latency <= bounds.latency) {
+                scratch.push_back({ { s.closed + childClosed, cost, latency }, { i, j } });
+            }
+        }
+    }
+
+    int minClosed = scratch.front().state.closed;
+    for (const Candidate& c : scratch) {
+        minClosed = std::min(minClosed, c.state.closed);
+    }
+    const int maxClosed = minClosed + remainingChildren;
+
+    std::sort(scratch.begin(), scratch.end(), [](const Candidate& a, const Candidate& b) {
+        return std::tie(a.state.closed, a.state.cost, a.state.latency, a.from.prev, a.from.childState) <
+               std::tie(b.state.closed, b.state.cost, b.state.latency, b.from.prev, b.from.childState);
+    });
+
+    // Sweep level by level; "lower" is the Pareto staircase (cost ascending, latency strictly
+    // descending) of every state kept on lower levels, which dominates states above it
+    std::vector<std::pair<int, int>> lower, level, merged;
+    std::vector<Candidate> kept;
+    std::vector<std::size_t> levelStart;
+    std::size_t i = 0;
+    while (i < scratch.size() && scratch[i].state.closed <= maxClosed) {
+        int closed = scratch[i].state.closed;
+        levelStart.push_back(kept.size());
+        level.clear();
+        int levelMinLatency = bounds.latency + 1;
+        bool first = true;
+        for (; i < scratch.size() && scratch[i].state.closed == closed; ++i) {
+            const State& s = scratch[i].state;
+            if (!first && s.latency >= levelMinLatency) {
+                continue;
+            }
+            auto it = std::upper_bound(lower.begin(), lower.end(), std::make_pair(s.cost, INT32_MAX));
+            if (it != lower.begin() && std::prev(it)->second <= s.latency) {
+                continue;
+            }
+            first = false;
+            levelMinLatency = s.latency;
+            kept.push_back(scratch[i]);
+            level.emplace_back(s.cost, s.latency);
+        }
+        if (levelStart.back() == kept.size()) {
+            levelStart.pop_back();
+            continue;
+        }
+
+        // Fold this level into the staircase of lower levels
+        merged.clear();
+        std::merge(lower.begin(), lower.end(), level.begin(), level.end(), std::back_inserter(merged));
+        lower.clear();
+        for (const auto& point : merged) {
+            if (lower.empty() || point.second < lower.back().second) {
+                if (!lower.empty() && lower.back().first == point.first) {
+                    lower.back().second = point.second;
+                } else {
+                    lower.push_back(point);
+                }
+            }
+        }
+    }
+
+    // Bounded frontier: keep whole levels from the lowest closed count up, thinning the
+    // first level evenly if it alone exceeds the bound
+    if (bounds.maxFrontier > 0 && kept.size() > bounds.maxFrontier) {
+        ++cappedSteps;
+        std::size_t levelEnd = levelStart.size() > 1 ? levelStart[1] : kept.size();
+        if (levelEnd > bounds.maxFrontier) {
+            std::vector<Candidate> thinned;
+            std::size_t keep = std::max<std::size_t>(bounds.maxFrontier, 2);
+            for (std::size_t k = 0; k < keep; ++k) {
+                thinned.push_back(kept[k * (levelEnd - 1) / (keep - 1)]);
+            }
+            kept.swap(thinned);
+        } else {
+            std::size_t cut = levelEnd;
+            for (std::size_t l = 1; l < levelStart.size(); ++l) {
+                std::size_t end = l + 1 < levelStart.size() ? levelStart[l + 1] : kept.size();
+                if (end > bounds.maxFrontier) {
+                    break;
+                }
+                cut = end;
+            }
+            kept.resize(cut);
+        }
+    }
+
+    next.clear();
+    if (provenance) {
+        provenance->clear();
+    }
+    for (const Candidate& c : kept) {
+        next.push_back(c.state);
+        if (provenance) {
+            provenance->push_back(c.from);
+        }
+    }
+}
+
+// Function to pick the state a freshly opened composite function starts from (lowest latency)
+int preferredState(int count) {
+    return count - 1;   // Final lists are sorted by cost ascending, latency descending
+}
+
+// Scaled problem shared by every DP step
+struct ScaledProblem {
+    const WorkflowTree& tree;
+    Bounds bounds;
+    double scale;
+
+    int scaledCost(int v) const { return static_cast<int>(std::floor(std::max(tree.cost(v), 0) / scale)); }
+};
+
+// Final frontier of every solved node. Each task appends to its own buffer, so disjoint
+// subtrees can be solved concurrently without sharing a growing array.
+struct FrontierStore {
+    std::vector<std::vector<State>> buffers;
+    std::vector<int> buffer, start, count;   // Per node: buffer, first state and number of states
+
+    const State* states(int v) const { return &buffers[buffer[v]][start[v]]; }
+};
+
+// Scratch space and statistics of one thread of work
+struct Workspace {
+    std::vector<State> current, next;
+    std::vector<Candidate> scratch;
+    std::vector<std::vector<Provenance>> steps;
+    std::size_t peakFrontier = 0;
+    std::size_t cappedSteps = 0;
+};
+
+// Function to run the merge steps of one node, leaving its final frontier in work.current
+void solveNode(const ScaledProblem& problem, int v, const FrontierStore& store, Workspace& work, bool keepProvenance) {
+    work.current.assign(1, { 0, problem.scaledCost(v), problem.tree.latency(v) });
+    ChildRange children = problem.tree.children(v);
+    if (keepProvenance) {
+        work.steps.resize(children.size());
+    }
+    for (std::size_t j = 0; j < children.size(); ++j) {
+        int c = children[j];
+        mergeChild(work.current, store.states(c), store.count[c], static_cast<int>(children.size() - j - 1),
+                   problem.bounds, work.scratch, work.next, keepProvenance ? &work.steps[j] : nullptr, work.cappedSteps);
+        work.current.swap(work.next);
+        work.peakFrontier = std::max(work.peakFrontier, work.current.size());
+    }
+}
+
+// Function to solve nodes bottom-up; topDown lists parents before children
+void solveBottomUp(const ScaledProblem& problem, const std::vector<int>& topDown, int bufferId, FrontierStore& store, Workspace& work) {
+    SASAP_PROFILE_SCOPE("bicriteria.solve");
+    std::vector<State>& buffer = store.buffers[bufferId];
+    for (auto it = topDown.rbegin(); it != topDown.rend(); ++it) {
+        int v = *it;
+        solveNode(problem, v, store, work, false);
+        store.buffer[v] = bufferId;
+        store.start[v] = static_cast<int>(buffer.size());
+        store.count[v] = static_cast<int>(work.current.size());
+        buffer.insert(buffer.end(), work.current.begin(), work.current.end());
+    }
+}
+
+// Function to decide, top-down, which child edges are cut and which child state is merged.
+// Each node's merge steps are replayed with provenance and the chosen final state is followed
+// back through them; chosen[] of the roots of topDown (the nodes listed before their
+// first child) must already be set.
+void reconstructTopDown(const ScaledProblem& problem, const std::vector<int>& topDown, const FrontierStore& store,
+                        Workspace& work, std::vector<int>& chosen, std::vector<char>& mergedWithParent) {
+    SASAP_PROFILE_SCOPE("bicriteria.reconstruct");
+    const std::size_t cappedBefore = work.cappedSteps;
+    for (int v : topDown) {
+        ChildRange children = problem.tree.children(v);
+        if (children.empty()) {
+            continue;
+        }
+        solveNode(problem, v, store, work, true);
+        int index = chosen[v];
+        for (std::size_t j = children.size(); j-- > 0;) {
+            const Provenance& from = work.steps[j][index];
+            int c = children[j];
+            if (from.childState < 0) {
+                chosen[c] = preferredState(store.count[c]);
+            } else {
+                mergedWithParent[c] = 1;
+                chosen[c] = from.childState;
+            }
+            index = from.prev;
+        }
+    }
+    work.cappedSteps = cappedBefore;   // Replays repeat the forward pass; count trims once
+}
+
+// Function to run the engine, splitting the tree into subtrees when a pool is given
+BicriteriaResult runBicriteria(const WorkflowTree& tree, int latencyLimit, int costLimit,
+                               const BicriteriaOptions& options, WorkStealingPool* pool, std::size_t targetTasks) {
+    BicriteriaResult result;
+    const int n = tree.size();
+    if (n == 0) {
+        return result;
+    }
+
+    // Bound the size of one composite function to choose the cost scale
+    int minCost = tree.cost(0), minLatency = tree.latency(0);
+    for (int v = 1; v < n; ++v) {
+        minCost = std::min(minCost, tree.cost(v));
+        minLatency = std::min(minLatency, tree.latency(v));
+    }
+    double maxMembers = n;
+    if (minCost > 0) maxMembers = std::min(maxMembers, std::floor(static_cast<double>(costLimit) / minCost));
+    if (minLatency > 0) maxMembers = std::min(maxMembers, std::floor(static_cast<double>(latencyLimit) / minLatency));
+    maxMembers = std::max(maxMembers, 1.0);
+    result.costScale = std::max(1.0, options.epsilon * costLimit / maxMembers);
+
+    const ScaledProblem problem = {
+        tree,
+        { static_cast<int>(std::floor(std::max(costLimit, 0) / result.costScale)), latencyLimit, options.maxFrontier },
+        result.costScale
+    };
+
+    // Without a pool the whole tree is one "spine"; with a pool the subtrees below the spine
+    // are solved concurrently first. The DP is exact per node, so both give the same result.
+    const std::vector<int> order = breadthFirstOrder(tree, tree.root());
+    SubtreeSplit split;
+    if (pool) {
+        split = splitIntoSubtrees(tree, targetTasks);
+    } else {
+        split.spine = order;
+    }
+    std::vector<std::vector<int>> taskOrders(split.taskCount());
+
+    FrontierStore store;
+    store.buffers.resize(split.taskCount() + 1);   // Buffer 0 holds the spine
+    store.buffer.assign(n, 0);
+    store.start.assign(n, 0);
+    store.count.assign(n, 0);
+    std::vector<Workspace> work(split.taskCount() + 1);
+
+    if (pool) {
+        pool->parallelFor(split.taskCount(), [&](std::size_t t) {
+            taskOrders[t] = taskOrder(tree, split, t);
+            solveBottomUp(problem, taskOrders[t], static_cast<int>(t + 1), store, work[t + 1]);
+        });
+    }
+    solveBottomUp(problem, split.spine, 0, store, work[0]);
+
+    std::vector<int> chosen(n, -1);
+    std::vector<char> mergedWithParent(n, 0);
+    chosen[tree.root()] = preferredState(store.count[tree.root()]);
+    reconstructTopDown(problem, split.spine, store, work[0], chosen, mergedWithParent);
+    if (pool) {
+        pool->parallelFor(split.taskCount(), [&](std::size_t t) {
+            reconstructTopDown(problem, taskOrders[t], store, work[t + 1], chosen, mergedWithParent);
+        });
+    }
+    for (const Workspace& w : work) {
+        result.peakFrontier = std::max(result.peakFrontier, w.peakFrontier);
+        result.cappedSteps += w.cappedSteps;
+    }
+
+    // Number the composite functions in breadth-first order of their head nodes
+    result.partitionOf.assign(n, -1);
+    int functions = 0;
+    for (int v : order) {
+        result.partitionOf[v] = mergedWithParent[v] ? result.partitionOf[tree.parent(v)] : functions++;
+    }
+    result.offset.assign(functions + 1, 0);
+    result.totalCost.assign(functions, 0);
+    result.totalLatency.assign(functions, 0);
+    for (int v = 0; v < n; ++v) {
+        int f = result.partitionOf[v];
+        ++result.offset[f + 1];
+        result.totalCost[f] += tree.cost(v);
+        result.totalLatency[f] += tree.latency(v);
+    }
+    for (int f = 0; f < functions; ++f) {
+        result.offset[f + 1] += result.offset[f];
+    }
+    result.nodes.resize(n);
+    std::vector<int> cursor(result.offset.begin(), result.offset.end() - 1);
+    for (int v : order) {
+        result.nodes[cursor[result.partitionOf[v]]++] = v;
+    }
+    return result;
+}
+
+} // namespace
+
+// Function to compute a bicriteria-approximate minimum partitioning of the tree
+BicriteriaResult bicriteriaPartition(const WorkflowTree& tree, int latencyLimit, int costLimit,
+                                     const BicriteriaOptions& options) {
+    return runBicriteria(tree, latencyLimit, costLimit, options, nullptr, 0);
+}
+
+// Function to compute the same partitioning with independent subtrees solved concurrently
+BicriteriaResult bicriteriaPartition(const WorkflowTree& tree, int latencyLimit, int costLimit,
+                                     const BicriteriaOptions& options, WorkStealingPool& pool, std::size_t targetTasks) {
+    return runBicriteria(tree, latencyLimit, costLimit, options, &pool, targetTasks);
+}
+
+} // namespace sasap
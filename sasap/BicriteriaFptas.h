@@ -0,0 +1,60 @@
+/*
+
+   Bicriteria FPTAS for partitioning a workflow tree into composite functions.
+
+   Every composite function is a connected subtree whose total latency must stay within
+   latencyLimit and whose total cost must stay within costLimit, and the number of composite
+   functions is minimised. With two additive bounds the problem is NP-hard, so costs are
+   scaled down by K = epsilon * costLimit / s (s bounds the size of one composite function)
+   and a bottom-up tree DP keeps, at every node, the Pareto frontier of (scaled cost, latency)
+   states of the composite function still open at that node. The result never uses more
+   composite functions than the optimum for the exact limits, and each composite function
+   exceeds costLimit by at most a factor (1 + epsilon), while latencyLimit is met exactly.
+
+*/
+
+#ifndef SASAP_BICRITERIA_FPTAS_H
+#define SASAP_BICRITERIA_FPTAS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "WorkflowTree.h"
+
+namespace sasap {
+
+// Tuning knobs of the bicriteria engine
+struct BicriteriaOptions {
+    double epsilon = 0.1;            // Cost relaxation: composite functions stay within (1 + epsilon) * costLimit
+    std::size_t maxFrontier = 256;   // Upper bound on states kept per DP step (0 = unbounded)
+};
+
+// Composite functions found by the engine, stored in CSR form
+struct BicriteriaResult {
+    std::vector<int> offset{0};      // Nodes of function f are nodes[offset[f] .. offset[f + 1])
+    std::vector<int> nodes;          // Node identifiers in breadth-first order within each function
+    std::vector<int> partitionOf;    // Composite function of every node
+    std::vector<std::int64_t> totalCost;      // True (unscaled) cost of every composite function
+    std::vector<std::int64_t> totalLatency;   // Latency of every composite function
+    double costScale = 1.0;          // Scaling factor K applied to node costs
+    std::size_t peakFrontier = 0;    // Largest number of states held by one DP step
+    std::size_t cappedSteps = 0;     // DP steps trimmed by maxFrontier (0 keeps the guarantee)
+
+    std::size_t size() const { return offset.size() - 1; }
+};
+
+class WorkStealingPool;
+
+// Function to compute a bicriteria-approximate minimum partitioning of the tree
+BicriteriaResult bicriteriaPartition(const WorkflowTree& tree, int latencyLimit, int costLimit,
+                                     const BicriteriaOptions& options = BicriteriaOptions());
+
+// Function to compute the same partitioning with independent subtrees solved concurrently.
+// The DP is exact per node, so the result is identical to the serial engine.
+BicriteriaResult bicriteriaPartition(const WorkflowTree& tree, int latencyLimit, int costLimit,
+                                     const BicriteriaOptions& options, WorkStealingPool& pool, std::size_t targetTasks = 256);
+
+} // namespace sasap
+
+#endif // SASAP_BICRITERIA_FPTAS_H
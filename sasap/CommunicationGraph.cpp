@@ -0,0 +1,109 @@
+#include "CommunicationGraph.h"
+
+#include <stdexcept>
+
+#include "Profiler.h"
+
+namespace sasap {
+
+// Function to aggregate linkages into a communication graph
+CommunicationGraph buildCommunicationGraph(const WorkflowTree& tree, const std::vector<int>& partitionOf, int partitionCount,
+                                           const LinkageList& linkages, const TrafficModel& model) {
+    SASAP_PROFILE_SCOPE("linkage.aggregate");
+    CommunicationGraph graph;
+    graph.edgeOffset.assign(partitionCount + 1, 0);
+
+    // Remote linkages as (source, target, secure), counted per target and per source
+    struct RemoteLinkage {
+        int from;
+        int to;
+        bool secure;
+    };
+    std::vector<RemoteLinkage> remote;
+    remote.reserve(linkages.size());
+    std::vector<int> targetCount(partitionCount + 1, 0);
+    for (const Linkage& linkage : linkages) {
+        if (linkage.fromNode < 0 || linkage.toNode < 0 || static_cast<std::size_t>(linkage.fromNode) >= partitionOf.size()
+            || static_cast<std::size_t>(linkage.toNode) >= partitionOf.size()) {
+            throw std::invalid_argument("CommunicationGraph: linkage endpoint outside the partition map");
+        }
+        int from = partitionOf[linkage.fromNode];
+        int to = partitionOf[linkage.toNode];
+        if (from < 0 || to < 0 || from >= partitionCount || to >= partitionCount) {
+            throw std::invalid_argument("CommunicationGraph: linkage endpoint without a partition");
+        }
+        if (from == to) {
+            ++graph.localLinkages;
+            continue;
+        }
+        remote.push_back({ from, to, tree.isSecure(linkage.fromNode) || tree.isSecure(linkage.toNode) });
+        ++targetCount[to + 1];
+        ++graph.edgeOffset[from + 1];
+    }
+    for (int p = 0; p < partitionCount; ++p) {
+        targetCount[p + 1] += targetCount[p];
+        graph.edgeOffset[p + 1] += graph.edgeOffset[p];
+    }
+
+    // Two stable counting sorts (by target, then by source) group the linkages by source with
+    // ascending targets, so equal pairs end up adjacent
+    std::vector<int> byTarget(remote.size());
+    for (std::size_t i = 0; i < remote.size(); ++i) {
+        byTarget[targetCount[remote[i].to]++] = static_cast<int>(i);
+    }
+    std::vector<int> bySource(remote.size());
+    std::vector<int> cursor(graph.edgeOffset.begin(), graph.edgeOffset.end() - 1);
+    for (int i : byTarget) {
+        bySource[cursor[remote[i].from]++] = i;
+    }
+
+    // Merge runs of equal pairs into edges; edgeOffset is rewritten from linkage to edge counts
+    const std::uint64_t secureBytes = model.payloadBytes + model.secureOverheadBytes;
+    std::size_t next = 0;
+    for (int p = 0; p < partitionCount; ++p) {
+        const std::size_t end = static_cast<std::size_t>(graph.edgeOffset[p + 1]);
+        graph.edgeOffset[p] = graph.edgeCount();
+        for (; next < end; ++next) {
+            const RemoteLinkage& linkage = remote[bySource[next]];
+            if (graph.edgeCount() == graph.edgeOffset[p] || graph.target.back() != linkage.to) {
+                graph.target.push_back(linkage.to);
+                graph.linkages.push_back(0);
+                graph.secureLinkages.push_back(0);
+                graph.bytes.push_back(0);
+            }
+            ++graph.linkages.back();
+            graph.secureLinkages.back() += linkage.secure ? 1 : 0;
+            graph.bytes.back() += linkage.secure ? secureBytes : model.payloadBytes;
+        }
+    }
+    graph.edgeOffset[partitionCount] = graph.edgeCount();
+    SASAP_PROFILE_COUNT("linkage.aggregatedEdges", graph.edgeCount());
+    return graph;
+}
+
+// Function to aggregate the linkages of a SASAP partitioning
+CommunicationGraph buildCommunicationGraph(const WorkflowTree& tree, const PartitionList& partitions,
+                                           const LinkageList& linkages, const TrafficModel& model) {
+    std::vector<int> partitionOf(tree.size(), -1);
+    for (std::size_t p = 0; p < partitions.size(); ++p) {
+        for (int node : partitions[p].nodes) {
+            partitionOf[node] = static_cast<int>(p);
+        }
+    }
+    return buildCommunicationGraph(tree, partitionOf, static_cast<int>(partitions.size()), linkages, model);
+}
+
+// Function to sum the edges of a communication graph
+CommunicationTotals communicationTotals(const CommunicationGraph& graph) {
+    CommunicationTotals totals;
+    totals.edges = graph.target.size();
+    for (int e = 0; e < graph.edgeCount(); ++e) {
+        totals.linkages += graph.linkages[e];
+        totals.secureLinkages += graph.secureLinkages[e];
+        totals.bytes += graph.bytes[e];
+        totals.secureBytes += graph.secureLinkages[e] > 0 ? graph.bytes[e] : 0;
+    }
+    return totals;
+}
+
+} // namespace sasap
@@ -0,0 +1,68 @@
+/*
+
+   Partition-level communication graph. After partitioning, the node-to-node linkages are
+   aggregated into one weighted edge per ordered pair of partitions that exchange data: the
+   number of linkages it carries, how many of them involve a secure node (and therefore an
+   encrypted transfer), and an estimate of the bytes sent. Linkages inside one partition are
+   local calls and are only counted. Edges are stored in CSR form by source partition with
+   ascending targets, so the deployment simulator and the cost reports walk partitions and
+   their outgoing edges without going back to the per-node linkages.
+
+*/
+
+#ifndef SASAP_COMMUNICATION_GRAPH_H
+#define SASAP_COMMUNICATION_GRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SasapPartitioning.h"
+#include "WorkflowTree.h"
+
+namespace sasap {
+
+// Bytes assumed for one linkage's payload
+struct TrafficModel {
+    std::size_t payloadBytes = 48;          // Data passed along one linkage
+    std::size_t secureOverheadBytes = 28;   // Nonce and tag of an AES-GCM frame around a secure payload
+};
+
+struct CommunicationGraph {
+    std::vector<int> edgeOffset;             // Edges leaving partition p are [edgeOffset[p], edgeOffset[p + 1])
+    std::vector<int> target;                 // Destination partition of every edge
+    std::vector<int> linkages;               // Linkages aggregated into every edge
+    std::vector<int> secureLinkages;         // Of those, linkages with a secure node at either end
+    std::vector<std::uint64_t> bytes;        // Estimated bytes sent along every edge
+    std::size_t localLinkages = 0;           // Linkages whose ends share a partition
+
+    int partitionCount() const { return static_cast<int>(edgeOffset.size()) - 1; }
+    int edgeCount() const { return static_cast<int>(target.size()); }
+    int firstEdge(int partition) const { return edgeOffset[partition]; }
+    int lastEdge(int partition) const { return edgeOffset[partition + 1]; }
+};
+
+// Totals over all edges of a communication graph
+struct CommunicationTotals {
+    std::size_t edges = 0;             // Partition pairs that communicate (remote invocations)
+    std::size_t linkages = 0;          // Linkages between different partitions
+    std::size_t secureLinkages = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t secureBytes = 0;     // Bytes on edges that carry at least one secure linkage
+};
+
+// Function to aggregate linkages into a communication graph; partitionOf maps every node to
+// its partition in [0, partitionCount). Throws std::invalid_argument for nodes outside that map.
+CommunicationGraph buildCommunicationGraph(const WorkflowTree& tree, const std::vector<int>& partitionOf, int partitionCount,
+                                           const LinkageList& linkages, const TrafficModel& model = TrafficModel());
+
+// Function to aggregate the linkages of a SASAP partitioning
+CommunicationGraph buildCommunicationGraph(const WorkflowTree& tree, const PartitionList& partitions,
+                                           const LinkageList& linkages, const TrafficModel& model = TrafficModel());
+
+// Function to sum the edges of a communication graph
+CommunicationTotals communicationTotals(const CommunicationGraph& graph);
+
+} // namespace sasap
+
+#endif // SASAP_COMMUNICATION_GRAPH_H
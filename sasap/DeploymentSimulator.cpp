@@ -0,0 +1,263 @@
+#include "DeploymentSimulator.h"
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <ostream>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+#include "Profiler.h"
+
+namespace sasap {
+
+namespace {
+
+enum class EventKind {
+    Arrival,        // index unused
+    GroupFinish,    // index is the group
+    TransferDone    // index is the graph edge
+};
+
+struct Event {
+    double time;
+    std::uint64_t sequence;   // Creation order, so simultaneous events are processed deterministically
+    EventKind kind;
+    int request;
+    int index;
+    int vcpu;
+
+    bool operator>(const Event& other) const {
+        return time != other.time ? time > other.time : sequence > other.sequence;
+    }
+};
+
+// Progress of one request through the workflow
+struct RequestState {
+    std::vector<int> missingInputs;   // Transfers every group still waits for; released once the request completes
+    std::size_t outstanding = 0;      // Groups and transfers not yet completed
+    double arrival = 0.0;
+    double last = 0.0;                // Time of the request's latest event
+};
+
+// Function to write the partitions of a group as "3+4" (1-based, as printed elsewhere)
+void writeGroup(std::ostream& out, const PartitionDag& dag, int group) {
+    for (int i = dag.memberOffset[group]; i < dag.memberOffset[group + 1]; ++i) {
+        out << (i == dag.memberOffset[group] ? "" : "+") << dag.members[i] + 1;
+    }
+}
+
+} // namespace
+
+// Function to simulate the deployment of the partitions
+DeploymentReport simulateDeployment(const WorkflowTree& tree, const PartitionList& partitions,
+                                    const CommunicationGraph& graph, const DeploymentModel& model,
+                                    std::ostream* trace) {
+    SASAP_PROFILE_SCOPE("deploy");
+    if (model.vcpus < 1 || model.requests < 1) {
+        throw std::invalid_argument("DeploymentModel: at least one vCPU and one request are needed");
+    }
+    if (model.msPerLatencyUnit < 0.0 || model.coldStartMs < 0.0 || model.keepAliveMs < 0.0 || model.transferMs < 0.0
+        || model.encryptNsPerByte < 0.0 || model.arrivalIntervalMs < 0.0 || !(model.bytesPerMs > 0.0)) {
+        throw std::invalid_argument("DeploymentModel: times must be non-negative and the bandwidth positive");
+    }
+    const int partitionCount = static_cast<int>(partitions.size());
+    if (graph.partitionCount() != partitionCount) {
+        throw std::invalid_argument("simulateDeployment: communication graph of another partitioning");
+    }
+
+    DeploymentReport report;
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(graph.edgeCount());
+    for (int p = 0; p < partitionCount; ++p) {
+        for (int e = graph.firstEdge(p); e < graph.lastEdge(p); ++e) {
+            edges.emplace_back(p, graph.target[e]);
+        }
+    }
+    report.dag = buildPartitionDag(partitionCount, edges);
+    const PartitionDag& dag = report.dag;
+    const int groupCount = dag.groupCount();
+
+    // Outgoing edges of every group, the inputs every group waits for, and the fixed durations
+    std::vector<int> outOffset(groupCount + 1, 0);
+    std::vector<int> outEdges(edges.size());
+    std::vector<int> inputs(groupCount, 0);
+    for (const auto& edge : edges) {
+        int from = dag.groupOf[edge.first], to = dag.groupOf[edge.second];
+        ++outOffset[from + 1];
+        if (from != to) {
+            ++inputs[to];
+        }
+    }
+    for (int g = 0; g < groupCount; ++g) {
+        outOffset[g + 1] += outOffset[g];
+    }
+    std::vector<int> nextOut(outOffset.begin(), outOffset.end() - 1);
+    for (std::size_t e = 0; e < edges.size(); ++e) {
+        outEdges[nextOut[dag.groupOf[edges[e].first]]++] = static_cast<int>(e);
+    }
+    std::vector<double> executionMs(groupCount, 0.0);
+    for (int g = 0; g < groupCount; ++g) {
+        for (int i = dag.memberOffset[g]; i < dag.memberOffset[g + 1]; ++i) {
+            for (int node : partitions[dag.members[i]].nodes) {
+                executionMs[g] += tree.latency(node) * model.msPerLatencyUnit;
+            }
+        }
+        report.serialMs += executionMs[g];
+    }
+    std::vector<double> transferMs(edges.size());
+    for (std::size_t e = 0; e < edges.size(); ++e) {
+        const bool encrypted = graph.secureLinkages[e] > 0;
+        transferMs[e] = model.transferMs + graph.bytes[e] / model.bytesPerMs
+                      + (encrypted ? graph.bytes[e] * model.encryptNsPerByte / 1e6 : 0.0);
+        report.serialMs += transferMs[e];
+    }
+    std::vector<int> sourceGroups;
+    for (int g = 0; g < groupCount; ++g) {
+        if (inputs[g] == 0) {
+            sourceGroups.push_back(g);
+        }
+    }
+
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+    std::uint64_t sequence = 0;
+    auto schedule = [&](double time, EventKind kind, int request, int index, int vcpu) {
+        events.push({ time, sequence++, kind, request, index, vcpu });
+    };
+    std::vector<RequestState> requests(model.requests);
+    for (int r = 0; r < model.requests; ++r) {
+        schedule(r * model.arrivalIntervalMs, EventKind::Arrival, r, -1, -1);
+    }
+
+    std::deque<std::pair<int, int>> ready;   // (request, group) in the order they became ready
+    std::priority_queue<int, std::vector<int>, std::greater<int>> freeVcpus;
+    for (int c = 0; c < model.vcpus; ++c) {
+        freeVcpus.push(c);
+    }
+    std::vector<std::vector<double>> warmUntil(partitionCount);   // Expiry of every idle instance, latest last
+    std::vector<int> cause(groupCount, -1);                      // First request: group whose transfer completed the inputs
+    int lastGroup = -1;
+    double responseSum = 0.0;
+    double now = 0.0;
+
+    auto dispatch = [&] {
+        while (!ready.empty() && !freeVcpus.empty()) {
+            const auto [request, group] = ready.front();
+            ready.pop_front();
+            const int vcpu = freeVcpus.top();
+            freeVcpus.pop();
+            std::size_t cold = 0;
+            for (int i = dag.memberOffset[group]; i < dag.memberOffset[group + 1]; ++i) {
+                std::vector<double>& idle = warmUntil[dag.members[i]];
+                if (!idle.empty() && idle.back() >= now) {
+                    idle.pop_back();
+                } else {
+                    idle.clear();   // The freshest instance has expired, so all have
+                    ++cold;
+                }
+            }
+            const double duration = executionMs[group] + cold * model.coldStartMs;
+            report.executions += dag.memberOffset[group + 1] - dag.memberOffset[group];
+            report.coldStarts += cold;
+            report.busyMs += duration;
+            schedule(now + duration, EventKind::GroupFinish, request, group, vcpu);
+            if (trace) {
+                *trace << "[" << now << " ms] request " << request << ": vCPU " << vcpu << " starts partitions ";
+                writeGroup(*trace, dag, group);
+                *trace << " (" << cold << " cold)" << '\n';
+            }
+        }
+    };
+    auto complete = [&](RequestState& state) {
+        const double response = state.last - state.arrival;
+        responseSum += response;
+        report.maxResponseMs = std::max(report.maxResponseMs, response);
+        std::vector<int>().swap(state.missingInputs);
+    };
+    auto progress = [&](RequestState& state) {
+        state.last = now;
+        if (--state.outstanding == 0) {
+            complete(state);
+        }
+    };
+
+    while (!events.empty()) {
+        const Event event = events.top();
+        events.pop();
+        now = event.time;
+        ++report.events;
+        RequestState& state = requests[event.request];
+        switch (event.kind) {
+            case EventKind::Arrival:
+                state.missingInputs = inputs;
+                state.outstanding = groupCount + edges.size();
+                state.arrival = now;
+                state.last = now;
+                for (int g : sourceGroups) {
+                    ready.emplace_back(event.request, g);
+                }
+                if (state.outstanding == 0) {
+                    complete(state);   // Nothing to run
+                }
+                break;
+
+            case EventKind::GroupFinish: {
+                const int group = event.index;
+                freeVcpus.push(event.vcpu);
+                for (int i = dag.memberOffset[group]; i < dag.memberOffset[group + 1]; ++i) {
+                    warmUntil[dag.members[i]].push_back(now + model.keepAliveMs);
+                }
+                for (int i = outOffset[group]; i < outOffset[group + 1]; ++i) {
+                    schedule(now + transferMs[outEdges[i]], EventKind::TransferDone, event.request, outEdges[i], -1);
+                }
+                if (event.request == 0) {
+                    lastGroup = group;
+                    report.criticalMs = now;
+                }
+                if (trace) {
+                    *trace << "[" << now << " ms] request " << event.request << ": partitions ";
+                    writeGroup(*trace, dag, group);
+                    *trace << " finish on vCPU " << event.vcpu << '\n';
+                }
+                progress(state);
+                break;
+            }
+
+            case EventKind::TransferDone: {
+                const int edge = event.index;
+                const int from = dag.groupOf[edges[edge].first], to = dag.groupOf[edges[edge].second];
+                const bool encrypted = graph.secureLinkages[edge] > 0;
+                ++report.transfers;
+                report.bytes += graph.bytes[edge];
+                report.encryptedBytes += encrypted ? graph.bytes[edge] : 0;
+                if (trace) {
+                    *trace << "[" << now << " ms] request " << event.request << ": partition " << edges[edge].first + 1
+                           << " -> " << edges[edge].second + 1 << " delivered (" << graph.linkages[edge] << " linkages, "
+                           << graph.bytes[edge] << " bytes" << (encrypted ? ", encrypted" : "") << ")" << '\n';
+                }
+                if (from != to && --state.missingInputs[to] == 0) {
+                    ready.emplace_back(event.request, to);
+                    if (event.request == 0) {
+                        cause[to] = from;
+                    }
+                }
+                progress(state);
+                break;
+            }
+        }
+        dispatch();
+    }
+
+    report.makespanMs = now;
+    report.meanResponseMs = responseSum / model.requests;
+    report.utilization = report.makespanMs > 0.0 ? report.busyMs / (model.vcpus * report.makespanMs) : 0.0;
+    for (int g = lastGroup; g != -1; g = cause[g]) {
+        report.criticalGroups.push_back(g);
+    }
+    std::reverse(report.criticalGroups.begin(), report.criticalGroups.end());
+    SASAP_PROFILE_COUNT("deploy.events", report.events);
+    return report;
+}
+
+} // namespace sasap
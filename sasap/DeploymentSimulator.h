@@ -0,0 +1,82 @@
+/*
+
+   Discrete-event simulation of deploying a partitioned workflow on a fixed number of vCPUs.
+   Time is virtual: events (request arrivals, group completions, transfer deliveries) sit in
+   a priority queue ordered by time and then by creation, and the clock jumps from one event
+   to the next, so a run takes as long as its event count demands rather than its simulated
+   duration, and the same inputs always give the same schedule.
+
+   Partitions form a DAG through the edges of their communication graph; cycles are
+   collapsed into groups that run as one task on one vCPU (see PartitionDag.h). A group is
+   ready once every transfer it receives from other groups has arrived, and ready groups
+   take free vCPUs in the order they became ready, the lowest-numbered vCPU first.
+
+     execution   each member node takes msPerLatencyUnit per unit of its latency; a member
+                 partition without an idle warm instance first pays coldStartMs, and its
+                 instance stays warm for keepAliveMs after the group finishes
+     transfer    one per graph edge, sent when its source group finishes: transferMs plus
+                 the edge's bytes over bytesPerMs, plus encryptNsPerByte for every byte when
+                 the edge carries a secure linkage; transfers use the network, not vCPUs
+
+   With several requests, request r arrives at r * arrivalIntervalMs and runs the whole
+   workflow again, so later requests can find the instances of earlier ones still warm.
+
+*/
+
+#ifndef SASAP_DEPLOYMENT_SIMULATOR_H
+#define SASAP_DEPLOYMENT_SIMULATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include "CommunicationGraph.h"
+#include "PartitionDag.h"
+#include "SasapPartitioning.h"
+#include "WorkflowTree.h"
+
+namespace sasap {
+
+// Platform parameters of the simulation, in virtual milliseconds
+struct DeploymentModel {
+    int vcpus = 1;
+    double msPerLatencyUnit = 10.0;      // Execution time of a node per unit of its latency
+    double coldStartMs = 250.0;          // Starting a composite function without a warm instance
+    double keepAliveMs = 60000.0;        // Idle time after which a warm instance is reclaimed
+    double transferMs = 5.0;             // Fixed cost of one remote transfer
+    double bytesPerMs = 125000.0;        // Network bandwidth (1 Gbit/s)
+    double encryptNsPerByte = 2.0;       // AES-GCM sealing and opening of secure transfers
+    int requests = 1;                    // Workflow requests to simulate
+    double arrivalIntervalMs = 0.0;      // Time between request arrivals
+};
+
+// Outcome of a simulation
+struct DeploymentReport {
+    PartitionDag dag;                    // Groups the partitions were scheduled as
+    double makespanMs = 0.0;             // Last event of the last request
+    double meanResponseMs = 0.0;         // Arrival of a request to its last event
+    double maxResponseMs = 0.0;
+    double serialMs = 0.0;               // One request's execution and transfers back to back, without cold starts
+    double busyMs = 0.0;                 // vCPU time spent executing, cold starts included
+    double utilization = 0.0;            // busyMs over vcpus * makespanMs
+    std::size_t executions = 0;          // Partition invocations
+    std::size_t coldStarts = 0;
+    std::size_t transfers = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t encryptedBytes = 0;
+    std::size_t events = 0;              // Events processed
+    std::vector<int> criticalGroups;     // First request: chain of transfers into its last group, first to last
+    double criticalMs = 0.0;             // First request: finish time of the last group
+};
+
+// Function to simulate the deployment of the partitions. Throws std::invalid_argument for a
+// model without vCPUs or requests, negative times, or a graph of another partitioning. When
+// trace is not null, every group start, group finish and transfer delivery is written to it.
+DeploymentReport simulateDeployment(const WorkflowTree& tree, const PartitionList& partitions,
+                                    const CommunicationGraph& graph, const DeploymentModel& model,
+                                    std::ostream* trace = nullptr);
+
+} // namespace sasap
+
+#endif // SASAP_DEPLOYMENT_SIMULATOR_H
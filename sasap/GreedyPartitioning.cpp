@@ -0,0 +1,102 @@
+#include "GreedyPartitioning.h"
+
+#include <cstdint>
+
+#include "Arena.h"
+#include "PlacementIndex.h"
+#include "Profiler.h"
+#include "SubtreeSplit.h"
+#include "WorkStealingPool.h"
+
+namespace sasap {
+
+namespace {
+
+// Running totals of one partition
+struct PartitionTotals {
+    std::int64_t totalCost = 0;
+    std::int64_t totalLatency = 0;
+};
+
+// Function to greedily place the nodes of one traversal order into partitions.
+// Every partition keeps running latency/cost totals and its remaining capacity lives in a
+// capacity index, so the first partition that fits is found in O(log P) instead of re-summing
+// every member of every partition for each node.
+void greedyPlaceNodes(const WorkflowTree& tree, const std::vector<int>& order, int latencyLimit, int memoryLimit,
+                      GreedyPartitions& partitions) {
+    SASAP_PROFILE_SCOPE("placement");
+    SASAP_PROFILE_COUNT("placement.attempts", order.size());
+    std::vector<PartitionTotals> totals;      // Running totals, parallel to partitions
+    CapacityIndex capacity(latencyLimit);     // Remaining latency/memory per partition
+
+    for (int node : order) {
+        int nodeLatency = tree.latency(node);
+        int nodeCost = tree.cost(node);
+
+        // Try to place the current node in the first existing partition that fits
+        int target = capacity.find(PlacementPolicy::FirstFit, nodeLatency, nodeCost);
+        if (target != -1) {
+            PartitionTotals& total = totals[target];
+            total.totalLatency += nodeLatency;
+            total.totalCost += nodeCost;
+            partitions[target].push_back(node);
+            capacity.update(target, static_cast<int>(latencyLimit - total.totalLatency), static_cast<int>(memoryLimit - total.totalCost));
+        } else {
+            // If the node couldn't be placed in any existing partition, create a new one
+            PartitionTotals total;
+            total.totalLatency = nodeLatency;
+            total.totalCost = nodeCost;
+            totals.push_back(total);
+            partitions.emplace_back(1, node);
+            capacity.add(latencyLimit - nodeLatency, memoryLimit - nodeCost);
+        }
+    }
+    SASAP_PROFILE_COUNT("placement.partitionsCreated", totals.size());
+    SASAP_PROFILE_COUNT("partition.binsScanned", capacity.binsScanned());
+}
+
+} // namespace
+
+// Function to perform greedy tree partitioning, visiting nodes in breadth-first order from the root
+GreedyPartitions greedyTreePartitioning(const WorkflowTree& tree, int latencyLimit, int memoryLimit,
+                                        std::pmr::memory_resource* resource) {
+    GreedyPartitions partitions(resource);
+    greedyPlaceNodes(tree, breadthFirstOrder(tree, tree.root()), latencyLimit, memoryLimit, partitions);
+    return partitions;
+}
+
+// Function to perform greedy partitioning of independent subtrees concurrently
+GreedyPartitions parallelGreedyTreePartitioning(const WorkflowTree& tree, int latencyLimit, int memoryLimit,
+                                                WorkStealingPool& pool, std::size_t targetTasks,
+                                                std::pmr::memory_resource* resource) {
+    SubtreeSplit split = splitIntoSubtrees(tree, targetTasks);
+
+    // Every task fills its own arena, which takes its first chunk only when the task allocates;
+    // the merge copies the lists into resource
+    struct SubtreeResult {
+        Arena arena{64 * 1024};
+        GreedyPartitions partitions{&arena};
+    };
+    std::vector<SubtreeResult> results(split.taskCount() + 1);   // Slot 0 holds the spine
+
+    pool.parallelFor(results.size(), [&](std::size_t task) {
+        const std::vector<int> order = task == 0 ? split.spine : taskOrder(tree, split, task - 1);
+        greedyPlaceNodes(tree, order, latencyLimit, memoryLimit, results[task].partitions);
+    });
+
+    SASAP_PROFILE_SCOPE("placement.merge");
+    std::size_t partitionCount = 0;
+    for (const auto& result : results) {
+        partitionCount += result.partitions.size();
+    }
+    GreedyPartitions partitions(resource);
+    partitions.reserve(partitionCount);
+    for (const auto& result : results) {
+        for (const auto& members : result.partitions) {
+            partitions.emplace_back(members.begin(), members.end());
+        }
+    }
+    return partitions;
+}
+
+} // namespace sasap
@@ -0,0 +1,40 @@
+/*
+
+   Greedy tree partitioning (GrTP). Nodes are visited in breadth-first order and each one
+   joins the first partition that still has room for its latency and memory (cost), or opens
+   a new partition. Security requirements are not taken into account. The partition lists
+   are pmr containers, so a run can be kept in one Arena.
+
+*/
+
+#ifndef SASAP_GREEDY_PARTITIONING_H
+#define SASAP_GREEDY_PARTITIONING_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "WorkflowTree.h"
+
+namespace sasap {
+
+class WorkStealingPool;
+
+// Member lists of the partitions; inner lists share the allocator of the outer one
+using GreedyPartitions = std::pmr::vector<std::pmr::vector<int>>;
+
+// Function to perform greedy tree partitioning, visiting nodes in breadth-first order from the root
+GreedyPartitions greedyTreePartitioning(const WorkflowTree& tree, int latencyLimit, int memoryLimit,
+                                        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+// Function to perform greedy partitioning of independent subtrees concurrently. The spine and
+// every task (a group of consecutive subtrees, see SubtreeSplit.h) are partitioned on their own
+// and concatenated in breadth-first order of their roots, so the result does not depend on the
+// number of threads.
+GreedyPartitions parallelGreedyTreePartitioning(const WorkflowTree& tree, int latencyLimit, int memoryLimit,
+                                                WorkStealingPool& pool, std::size_t targetTasks = 256,
+                                                std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+} // namespace sasap
+
+#endif // SASAP_GREEDY_PARTITIONING_H
@@ -0,0 +1,353 @@
+#include "IncrementalPartitioning.h"
+
+#include <climits>
+#include <stdexcept>
+#include <string>
+
+#include "Profiler.h"
+
+namespace sasap {
+
+// Function to partition the tree as improvedTreePartitioning would and keep the state for repairs
+IncrementalPartitioner::IncrementalPartitioner(const WorkflowTree& tree, int latencyLimit, int memoryLimit,
+                                               PlacementPolicy policy)
+    : latencyLimit_(latencyLimit), memoryLimit_(memoryLimit), index_(latencyLimit, memoryLimit, policy) {
+    const int n = tree.size();
+    cost_ = tree.costs();
+    latency_ = tree.latencies();
+    secure_ = tree.secureFlags();
+    parent_ = tree.parents();
+    alive_.assign(n, 1);
+    firstChild_.assign(n, -1);
+    lastChild_.assign(n, -1);
+    nextSibling_.assign(n, -1);
+    prevSibling_.assign(n, -1);
+    partitionOf_.assign(n, -1);
+    positionOf_.assign(n, -1);
+    linkageOf_.assign(n, -1);
+    liveNodes_ = n;
+    for (int node = 0; node < n; ++node) {
+        for (int child : tree.children(node)) {
+            linkChild(node, child);
+        }
+    }
+    if (n == 0) {
+        return;
+    }
+
+    // Same visiting order as improvedTreePartitioning, so the initial partitions and linkages match it
+    linkages_.reserve(n - 1);
+    for (int node : breadthFirstOrder(tree, tree.root())) {
+        place(node);
+        for (int child : tree.children(node)) {
+            addLinkage(node, child);
+        }
+    }
+    stats_ = RepairStats();
+}
+
+// Function to apply a delta and repair the affected partitions and linkages
+RepairStats IncrementalPartitioner::apply(const WorkflowDelta& delta) {
+    SASAP_PROFILE_SCOPE("placement.repair");
+    for (int partition : touchedList_) {
+        touched_[partition] = 0;   // Left over if the previous delta threw
+    }
+    touchedList_.clear();
+    stats_ = RepairStats();
+
+    for (const NodeUpdate& update : delta.updates) {
+        applyUpdate(update);
+    }
+    for (int root : delta.removals) {
+        applyRemoval(root);
+    }
+    for (const SubtreeInsertion& insertion : delta.insertions) {
+        applyInsertion(insertion);
+    }
+
+    stats_.partitionsTouched = touchedList_.size();
+    SASAP_PROFILE_COUNT("placement.attempts", stats_.nodesPlaced);
+    SASAP_PROFILE_COUNT("placement.partitionsCreated", stats_.partitionsCreated);
+    for (int partition : touchedList_) {
+        touched_[partition] = 0;
+    }
+    touchedList_.clear();
+    return stats_;
+}
+
+void IncrementalPartitioner::applyUpdate(const NodeUpdate& update) {
+    if (!isAlive(update.node)) {
+        throw std::invalid_argument("IncrementalPartitioner: update of unknown node " + std::to_string(update.node));
+    }
+    const int node = update.node;
+    Partition& partition = partitions_[partitionOf_[node]];
+    std::int64_t newCost = partition.totalCost - cost_[node] + update.cost;
+    std::int64_t newLatency = partition.totalLatency - latency_[node] + update.latency;
+
+    // A node stays where it is while its partition still admits it; a lone node always fits its own partition
+    bool kindAllowed = !update.secure || partition.hasSecureNode;
+    bool fits = partition.nodes.size() == 1 || (newCost <= memoryLimit_ && newLatency <= latencyLimit_);
+    if (kindAllowed && fits) {
+        partition.totalCost = newCost;
+        partition.totalLatency = newLatency;
+        cost_[node] = update.cost;
+        latency_[node] = update.latency;
+        countSecure(partitionOf_[node], (update.secure ? 1 : 0) - secure_[node]);
+        secure_[node] = update.secure ? 1 : 0;
+        index_.updatePartition(partitionOf_[node], static_cast<int>(newLatency), static_cast<int>(newCost));
+        touch(partitionOf_[node]);
+        ++stats_.updatedInPlace;
+        return;
+    }
+
+    // Otherwise the node leaves (the rest of the partition met the limits before) and is placed again
+    detach(node);
+    cost_[node] = update.cost;
+    latency_[node] = update.latency;
+    secure_[node] = update.secure ? 1 : 0;
+    place(node);
+}
+
+void IncrementalPartitioner::applyRemoval(int root) {
+    if (!isAlive(root)) {
+        throw std::invalid_argument("IncrementalPartitioner: removal of unknown node " + std::to_string(root));
+    }
+    if (parent_[root] < 0) {
+        throw std::invalid_argument("IncrementalPartitioner: the root of the workflow cannot be removed");
+    }
+
+    unlinkChild(root);
+    std::vector<int> queue = { root };
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        int node = queue[head];
+        for (int child = firstChild_[node]; child != -1; child = nextSibling_[child]) {
+            queue.push_back(child);
+        }
+        removeLinkage(node);
+        detach(node);
+        alive_[node] = 0;
+        --liveNodes_;
+        ++stats_.nodesRemoved;
+    }
+}
+
+void IncrementalPartitioner::applyInsertion(const SubtreeInsertion& insertion) {
+    const std::size_t count = insertion.localParent.size();
+    if (!isAlive(insertion.parent)) {
+        throw std::invalid_argument("IncrementalPartitioner: insertion below unknown node " + std::to_string(insertion.parent));
+    }
+    if (count == 0 || insertion.cost.size() != count || insertion.latency.size() != count || insertion.secure.size() != count) {
+        throw std::invalid_argument("IncrementalPartitioner: inserted subtree needs one cost, latency and secure flag per node");
+    }
+    if (count > static_cast<std::size_t>(INT_MAX - nodeLimit())) {
+        throw std::invalid_argument("IncrementalPartitioner: too many nodes");
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        int local = insertion.localParent[i];
+        if (i == 0 ? local != -1 : (local < 0 || static_cast<std::size_t>(local) >= i)) {
+            throw std::invalid_argument("IncrementalPartitioner: inserted subtree must list parents before children, root first");
+        }
+    }
+
+    const int base = nodeLimit();
+    for (std::size_t i = 0; i < count; ++i) {
+        int parent = i == 0 ? insertion.parent : base + insertion.localParent[i];
+        addNode(insertion.cost[i], insertion.latency[i], insertion.secure[i] != 0, parent);
+    }
+
+    // Breadth-first placement, as in a full run
+    std::vector<int> queue = { base };
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        int node = queue[head];
+        place(node);
+        for (int child = firstChild_[node]; child != -1; child = nextSibling_[child]) {
+            queue.push_back(child);
+        }
+    }
+}
+
+int IncrementalPartitioner::addNode(int cost, int latency, bool secure, int parent) {
+    int id = nodeLimit();
+    cost_.push_back(cost);
+    latency_.push_back(latency);
+    secure_.push_back(secure ? 1 : 0);
+    alive_.push_back(1);
+    parent_.push_back(parent);
+    firstChild_.push_back(-1);
+    lastChild_.push_back(-1);
+    nextSibling_.push_back(-1);
+    prevSibling_.push_back(-1);
+    partitionOf_.push_back(-1);
+    positionOf_.push_back(-1);
+    linkageOf_.push_back(-1);
+    ++liveNodes_;
+    linkChild(parent, id);
+    addLinkage(parent, id);
+    return id;
+}
+
+// Function to append a node to the end of its parent's child list
+void IncrementalPartitioner::linkChild(int parent, int child) {
+    parent_[child] = parent;
+    prevSibling_[child] = lastChild_[parent];
+    nextSibling_[child] = -1;
+    if (lastChild_[parent] != -1) {
+        nextSibling_[lastChild_[parent]] = child;
+    } else {
+        firstChild_[parent] = child;
+    }
+    lastChild_[parent] = child;
+}
+
+// Function to cut a node out of its parent's child list
+void IncrementalPartitioner::unlinkChild(int node) {
+    int parent = parent_[node];
+    int prev = prevSibling_[node];
+    int next = nextSibling_[node];
+    (prev != -1 ? nextSibling_[prev] : firstChild_[parent]) = next;
+    (next != -1 ? prevSibling_[next] : lastChild_[parent]) = prev;
+    prevSibling_[node] = nextSibling_[node] = -1;
+}
+
+void IncrementalPartitioner::addLinkage(int parent, int child) {
+    linkageOf_[child] = static_cast<int>(linkages_.size());
+    linkages_.push_back({ parent, child });
+    ++stats_.linkagesAdded;
+}
+
+// Function to drop the edge into child; the last edge fills the gap
+void IncrementalPartitioner::removeLinkage(int child) {
+    int slot = linkageOf_[child];
+    if (slot < 0) {
+        return;
+    }
+    linkages_[slot] = linkages_.back();
+    linkageOf_[linkages_[slot].toNode] = slot;
+    linkages_.pop_back();
+    linkageOf_[child] = -1;
+    ++stats_.linkagesRemoved;
+}
+
+// Function to put a node into the partition the placement policy picks, or a new one
+void IncrementalPartitioner::place(int node) {
+    bool secure = secure_[node] != 0;
+    int target = index_.findPartition(latency_[node], cost_[node], secure);
+    if (target == -1) {
+        target = static_cast<int>(partitions_.size());
+        partitions_.push_back({ 0, 0, std::pmr::vector<int>(partitions_.get_allocator().resource()), secure });
+        secureMembers_.push_back(0);
+        index_.addPartition(target, 0, 0, secure);
+        ++stats_.partitionsCreated;
+    }
+
+    Partition& partition = partitions_[target];
+    if (partition.nodes.empty()) {
+        ++nonEmptyPartitions_;
+    }
+    partitionOf_[node] = target;
+    positionOf_[node] = static_cast<int>(partition.nodes.size());
+    partition.nodes.push_back(node);
+    partition.totalCost += cost_[node];
+    partition.totalLatency += latency_[node];
+    index_.updatePartition(target, static_cast<int>(partition.totalLatency), static_cast<int>(partition.totalCost));
+    countSecure(target, secure_[node]);
+    touch(target);
+    ++stats_.nodesPlaced;
+}
+
+// Function to take a node out of its partition; an emptied partition stays available for reuse
+void IncrementalPartitioner::detach(int node) {
+    int target = partitionOf_[node];
+    Partition& partition = partitions_[target];
+    int last = partition.nodes.back();
+    partition.nodes[positionOf_[node]] = last;
+    positionOf_[last] = positionOf_[node];
+    partition.nodes.pop_back();
+    partition.totalCost -= cost_[node];
+    partition.totalLatency -= latency_[node];
+    if (partition.nodes.empty()) {
+        --nonEmptyPartitions_;
+    }
+    index_.updatePartition(target, static_cast<int>(partition.totalLatency), static_cast<int>(partition.totalCost));
+    countSecure(target, -secure_[node]);
+    partitionOf_[node] = positionOf_[node] = -1;
+    touch(target);
+}
+
+// Function to adjust the secure member count of a partition; a partition that gains its first
+// or loses its last secure node changes kind, so later placements see what it holds now
+void IncrementalPartitioner::countSecure(int partition, int change) {
+    if (change == 0) {
+        return;
+    }
+    secureMembers_[partition] += change;
+    const bool secure = secureMembers_[partition] > 0;
+    if (secure != partitions_[partition].hasSecureNode) {
+        partitions_[partition].hasSecureNode = secure;
+        index_.setPartitionSecure(partition, secure);
+    }
+}
+
+void IncrementalPartitioner::touch(int partition) {
+    if (static_cast<std::size_t>(partition) >= touched_.size()) {
+        touched_.resize(partitions_.size(), 0);
+    }
+    if (!touched_[partition]) {
+        touched_[partition] = 1;
+        touchedList_.push_back(partition);
+    }
+}
+
+// Function to copy out the non-empty partitions in creation order
+PartitionList IncrementalPartitioner::partitions(std::pmr::memory_resource* resource) const {
+    PartitionList result(resource);
+    result.reserve(nonEmptyPartitions_);
+    for (const Partition& partition : partitions_) {
+        if (!partition.nodes.empty()) {
+            result.push_back({ partition.totalCost, partition.totalLatency,
+                               std::pmr::vector<int>(partition.nodes.begin(), partition.nodes.end(), resource),
+                               partition.hasSecureNode });
+        }
+    }
+    return result;
+}
+
+// Function to check the partitions and linkages against the live workflow
+bool IncrementalPartitioner::satisfiesConstraints() const {
+    std::size_t members = 0;
+    for (std::size_t index = 0; index < partitions_.size(); ++index) {
+        const Partition& partition = partitions_[index];
+        std::int64_t totalCost = 0;
+        std::int64_t totalLatency = 0;
+        int secureMembers = 0;
+        for (int node : partition.nodes) {
+            if (!isAlive(node) || &partitions_[partitionOf_[node]] != &partition || partition.nodes[positionOf_[node]] != node) {
+                return false;
+            }
+            secureMembers += secure_[node];
+            totalCost += cost_[node];
+            totalLatency += latency_[node];
+        }
+        if (totalCost != partition.totalCost || totalLatency != partition.totalLatency) {
+            return false;
+        }
+        if (secureMembers != secureMembers_[index] || partition.hasSecureNode != (secureMembers > 0)) {
+            return false;
+        }
+        if (partition.nodes.size() > 1 && (totalCost > memoryLimit_ || totalLatency > latencyLimit_)) {
+            return false;
+        }
+        members += partition.nodes.size();
+    }
+    if (members != static_cast<std::size_t>(liveNodes_) || linkages_.size() != static_cast<std::size_t>(liveNodes_ > 0 ? liveNodes_ - 1 : 0)) {
+        return false;
+    }
+    for (const Linkage& linkage : linkages_) {
+        if (!isAlive(linkage.fromNode) || !isAlive(linkage.toNode) || parent_[linkage.toNode] != linkage.fromNode) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace sasap
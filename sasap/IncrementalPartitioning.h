@@ -0,0 +1,148 @@
+/*
+
+   Incremental SASAP. The partitioner keeps a mutable copy of the workflow together with
+   the partitions, their placement index and the linkages, and applies deltas (attribute
+   updates, subtree insertions and subtree removals) by repairing only the partitions that
+   the changed nodes belong to. Node identifiers stay stable: removed nodes leave a gap and
+   inserted nodes get fresh identifiers after the current ones.
+
+   The initial state is exactly what improvedTreePartitioning produces. After a delta every
+   partition still satisfies the same constraints as a full run (latency and memory limits,
+   secure nodes only in secure partitions), but the placement may differ from what a full
+   run on the changed workflow would choose.
+
+*/
+
+#ifndef SASAP_INCREMENTAL_PARTITIONING_H
+#define SASAP_INCREMENTAL_PARTITIONING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "PlacementIndex.h"
+#include "SasapPartitioning.h"
+#include "WorkflowTree.h"
+
+namespace sasap {
+
+// New attributes of an existing node
+struct NodeUpdate {
+    int node;
+    int cost;
+    int latency;
+    bool secure;
+};
+
+// Subtree attached below an existing node. Local node i has localParent[i] < i, and local node 0
+// (parent -1) becomes a child of the node given by parent.
+struct SubtreeInsertion {
+    int parent;
+    std::vector<int> cost;
+    std::vector<int> latency;
+    std::vector<std::uint8_t> secure;
+    std::vector<int> localParent;
+};
+
+// Changes applied by one call to IncrementalPartitioner::apply, in this order:
+// updates, removals (subtree roots), insertions
+struct WorkflowDelta {
+    std::vector<NodeUpdate> updates;
+    std::vector<int> removals;
+    std::vector<SubtreeInsertion> insertions;
+};
+
+// Work done while applying a delta
+struct RepairStats {
+    std::size_t updatedInPlace = 0;      // Updated nodes that still fit their partition
+    std::size_t nodesPlaced = 0;         // Nodes (moved or inserted) that went through placement
+    std::size_t nodesRemoved = 0;
+    std::size_t partitionsCreated = 0;
+    std::size_t partitionsTouched = 0;   // Distinct partitions whose members or totals changed
+    std::size_t linkagesAdded = 0;
+    std::size_t linkagesRemoved = 0;
+};
+
+class IncrementalPartitioner {
+public:
+    // Function to partition the tree as improvedTreePartitioning would and keep the state for repairs
+    IncrementalPartitioner(const WorkflowTree& tree, int latencyLimit, int memoryLimit,
+                           PlacementPolicy policy = PlacementPolicy::FirstFit);
+
+    // Function to apply a delta and repair the affected partitions and linkages.
+    // Throws std::invalid_argument for unknown or removed nodes and for malformed subtrees;
+    // operations before the offending one stay applied.
+    RepairStats apply(const WorkflowDelta& delta);
+
+    int nodeCount() const { return liveNodes_; }            // Live nodes
+    int nodeLimit() const { return static_cast<int>(parent_.size()); }   // Identifiers are below this bound
+    bool isAlive(int node) const { return node >= 0 && node < nodeLimit() && alive_[node] != 0; }
+    int cost(int node) const { return cost_[node]; }
+    int latency(int node) const { return latency_[node]; }
+    bool isSecure(int node) const { return secure_[node] != 0; }
+    int parent(int node) const { return parent_[node]; }
+    int partitionOf(int node) const { return partitionOf_[node]; }
+
+    // Number of non-empty partitions
+    int partitionCount() const { return nonEmptyPartitions_; }
+
+    // Every parent-child edge of the live workflow (order changes as edges come and go)
+    const LinkageList& linkages() const { return linkages_; }
+
+    // Function to copy out the non-empty partitions in creation order
+    PartitionList partitions(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+
+    // Function to check that every live node sits in exactly one partition, that every
+    // partition meets the limits (multi-node partitions only) and that it is marked secure
+    // exactly when it holds a secure node
+    bool satisfiesConstraints() const;
+
+private:
+    int addNode(int cost, int latency, bool secure, int parent);
+    void linkChild(int parent, int child);
+    void unlinkChild(int node);
+    void addLinkage(int parent, int child);
+    void removeLinkage(int child);
+    void place(int node);
+    void detach(int node);
+    void touch(int partition);
+    void countSecure(int partition, int change);
+    void applyUpdate(const NodeUpdate& update);
+    void applyRemoval(int root);
+    void applyInsertion(const SubtreeInsertion& insertion);
+
+    int latencyLimit_;
+    int memoryLimit_;
+    PlacementIndex index_;
+
+    // Workflow columns; children form doubly linked sibling lists so subtrees can be cut and attached in O(1)
+    std::vector<int> cost_;
+    std::vector<int> latency_;
+    std::vector<std::uint8_t> secure_;
+    std::vector<std::uint8_t> alive_;
+    std::vector<int> parent_;
+    std::vector<int> firstChild_;
+    std::vector<int> lastChild_;
+    std::vector<int> nextSibling_;
+    std::vector<int> prevSibling_;
+    int liveNodes_ = 0;
+
+    // Partition state
+    PartitionList partitions_;          // Every partition ever created; hasSecureNode marks its kind
+    std::vector<int> secureMembers_;    // Secure members of every partition; hasSecureNode is secureMembers_ > 0
+    std::vector<int> partitionOf_;      // Partition of every live node
+    std::vector<int> positionOf_;       // Index of every live node inside its partition's member list
+    int nonEmptyPartitions_ = 0;
+
+    LinkageList linkages_;              // Parent-child edges
+    std::vector<int> linkageOf_;        // Index of the edge into every node (-1 for the root)
+
+    std::vector<std::uint8_t> touched_; // Partitions touched by the current delta
+    std::vector<int> touchedList_;
+    RepairStats stats_;                 // Statistics of the delta being applied
+};
+
+} // namespace sasap
+
+#endif // SASAP_INCREMENTAL_PARTITIONING_H
@@ -0,0 +1,79 @@
+#include "LeftRightTraversal.h"
+
+#include <stack>
+#include <tuple>
+
+#include "Profiler.h"
+#include "QoS.h"
+
+namespace sasap {
+
+// Left-Right (Hybrid) Tree Traversal Procedure
+std::vector<std::pair<int, int>> leftRightTreeTraversal(const WorkflowTree& tree) {
+    SASAP_PROFILE_SCOPE("traversal.leftRight");
+    std::vector<std::pair<int, int>> traversalResult;
+    std::stack<std::tuple<int, int, int>> stack;
+
+    if (!tree.empty()) {
+        stack.push(std::make_tuple(tree.root(), -1, 0)); // (-1 indicates root is being visited)
+    }
+
+    while (!stack.empty()) {
+        auto [node, parent_index, index] = stack.top();
+        stack.pop();
+
+        // Process node
+        traversalResult.push_back(std::make_pair(node, tree.cost(node)));
+
+        // Push children onto the stack in reverse order (right-to-left traversal)
+        ChildRange children = tree.children(node);
+        for (int i = static_cast<int>(children.size()) - 1; i >= 0; --i) {
+            stack.push(std::make_tuple(children[i], index, i));
+        }
+    }
+
+    return traversalResult;
+}
+
+// Function to build composite functions in a single pass over the traversal
+LeftRightResult buildCompositeFunctions(const WorkflowTree& tree, const std::vector<std::pair<int, int>>& traversalResult,
+                                        int costLimit, int latencyLimit) {
+    SASAP_PROFILE_SCOPE("placement");
+    LeftRightResult functions;
+    std::vector<bool> absorbed(tree.size(), false);
+    functions.memberOffset.push_back(0);
+    functions.members.reserve(tree.size());
+
+    for (auto [id, cost] : traversalResult) {
+        if (absorbed[id]) {
+            continue;
+        }
+
+        // The head node is looked up directly by id and its children join the composite function
+        std::int64_t totalCost = cost, totalLatency = tree.latency(id);
+        for (int child : tree.children(id)) {
+            functions.members.push_back(child);
+            absorbed[child] = true;
+            totalCost += tree.cost(child);
+            totalLatency += tree.latency(child);
+        }
+
+        functions.heads.push_back(id);
+        functions.memberOffset.push_back(static_cast<int>(functions.members.size()));
+        functions.totalCost.push_back(totalCost);
+        functions.totalLatency.push_back(totalLatency);
+    }
+
+    // Score all composite functions in one pass over the total columns
+    functions.qos.resize(functions.size());
+    functions.overallQoS = evaluateQoS(functions.totalCost.data(), functions.totalLatency.data(), functions.size(),
+                                       costLimit, latencyLimit, QoSModel::Satisfaction, nullptr, functions.qos.data());
+    return functions;
+}
+
+// Function to run the traversal and build its composite functions
+LeftRightResult leftRightPartition(const WorkflowTree& tree, int costLimit, int latencyLimit) {
+    return buildCompositeFunctions(tree, leftRightTreeTraversal(tree), costLimit, latencyLimit);
+}
+
+} // namespace sasap
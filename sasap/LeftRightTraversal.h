@@ -0,0 +1,48 @@
+/*
+
+   Left-right (hybrid) tree traversal partitioning (LRTP). The tree is walked depth-first,
+   left to right, and every node not yet absorbed by an earlier composite function opens a
+   new composite function holding itself and its children.
+
+*/
+
+#ifndef SASAP_LEFT_RIGHT_TRAVERSAL_H
+#define SASAP_LEFT_RIGHT_TRAVERSAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "WorkflowTree.h"
+
+namespace sasap {
+
+// Composite functions produced from the left-right traversal, stored in CSR form
+struct LeftRightResult {
+    std::vector<int> heads;          // Node that opened each composite function
+    std::vector<int> memberOffset;   // Members of function f are members[memberOffset[f] .. memberOffset[f + 1])
+    std::vector<int> members;        // Children of each head, in tree order
+    std::vector<std::int64_t> totalCost;      // Cost of the head plus its members
+    std::vector<std::int64_t> totalLatency;   // Latency of the head plus its members
+    std::vector<double> qos;         // QoS satisfaction of each composite function
+    double overallQoS = 0.0;         // Mean QoS satisfaction over all composite functions
+
+    std::size_t size() const { return heads.size(); }
+};
+
+// Left-Right (Hybrid) Tree Traversal Procedure: (node, cost) pairs in depth-first, left-to-right order
+std::vector<std::pair<int, int>> leftRightTreeTraversal(const WorkflowTree& tree);
+
+// Function to build composite functions in a single pass over the traversal.
+// Every node not yet absorbed by an earlier composite function opens a new one holding its
+// children, so each node is touched at most twice and the whole build is O(n).
+LeftRightResult buildCompositeFunctions(const WorkflowTree& tree, const std::vector<std::pair<int, int>>& traversalResult,
+                                        int costLimit, int latencyLimit);
+
+// Function to run the traversal and build its composite functions
+LeftRightResult leftRightPartition(const WorkflowTree& tree, int costLimit, int latencyLimit);
+
+} // namespace sasap
+
+#endif // SASAP_LEFT_RIGHT_TRAVERSAL_H
@@ -0,0 +1,144 @@
+#include "LimitSweep.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+
+#include "Arena.h"
+#include "CommunicationGraph.h"
+#include "MinimumPartitioning.h"
+#include "Profiler.h"
+#include "QoS.h"
+#include "SasapPartitioning.h"
+#include "WorkStealingPool.h"
+
+namespace sasap {
+
+// Function to parse "placement", "locality" or "minimum"
+SweepPartitioner parseSweepPartitioner(const std::string& name) {
+    if (name == "placement") return SweepPartitioner::Placement;
+    if (name == "locality") return SweepPartitioner::Locality;
+    if (name == "minimum") return SweepPartitioner::Minimum;
+    throw std::invalid_argument("unknown sweep partitioner: " + name);
+}
+
+// Function to return the command line name of a sweep partitioner
+const char* sweepPartitionerName(SweepPartitioner partitioner) {
+    switch (partitioner) {
+        case SweepPartitioner::Placement: return "placement";
+        case SweepPartitioner::Locality: return "locality";
+        case SweepPartitioner::Minimum: return "minimum";
+    }
+    return "unknown";
+}
+
+// Function to evaluate every point of the grid on the pool
+std::vector<SweepResult> sweepLimits(const WorkflowTree& tree, const SweepGrid& grid, const SweepOptions& options,
+                                     WorkStealingPool& pool) {
+    for (int limit : grid.latencyLimits) {
+        if (limit < 1) {
+            throw std::invalid_argument("sweep: latency limits must be positive");
+        }
+    }
+    for (int limit : grid.memoryLimits) {
+        if (limit < 1) {
+            throw std::invalid_argument("sweep: memory limits must be positive");
+        }
+    }
+    for (double ratio : grid.secureRatios) {
+        if (!(ratio >= 0.0 && ratio <= 1.0)) {
+            throw std::invalid_argument("sweep: secure ratios must be between 0 and 1");
+        }
+    }
+
+    // One variant per secure ratio; variants share the tree's structure and own only their
+    // secure flags, so the breadth-first order is the same for all
+    std::vector<WorkflowTree> variants;
+    std::vector<double> ratios;
+    if (grid.secureRatios.empty()) {
+        variants.push_back(tree);
+        const auto& flags = tree.secureFlags();
+        ratios.push_back(tree.empty() ? 0.0 : static_cast<double>(std::count(flags.begin(), flags.end(), std::uint8_t{1})) / tree.size());
+    } else {
+        variants.reserve(grid.secureRatios.size());
+        for (double ratio : grid.secureRatios) {
+            int secureNodeCount = static_cast<int>(ratio * tree.size() + 0.5);
+            std::vector<std::uint8_t> secure(tree.size(), 0);
+            std::fill(secure.begin(), secure.begin() + secureNodeCount, std::uint8_t{1});
+            variants.push_back(tree.withSecureFlags(std::move(secure)));
+            ratios.push_back(tree.empty() ? ratio : static_cast<double>(secureNodeCount) / tree.size());
+        }
+    }
+    const std::vector<int> order = tree.empty() ? std::vector<int>() : breadthFirstOrder(tree, tree.root());
+
+    // Grid order: secure ratio, then latency limit, then memory limit
+    const std::size_t latencyCount = grid.latencyLimits.size();
+    const std::size_t memoryCount = grid.memoryLimits.size();
+    std::vector<SweepResult> results(variants.size() * latencyCount * memoryCount);
+    pool.parallelFor(results.size(), [&](std::size_t point) {
+        SASAP_PROFILE_SCOPE("sweep.point");
+        const std::size_t variant = point / (latencyCount * memoryCount);
+        const int latencyLimit = grid.latencyLimits[point / memoryCount % latencyCount];
+        const int memoryLimit = grid.memoryLimits[point % memoryCount];
+        const WorkflowTree& variantTree = variants[variant];
+
+        // The arena is not thread-safe, so every point allocates from its own
+        Arena arena(256 * 1024);
+        LinkageList linkages(&arena);
+        PartitionList partitions(&arena);
+        auto start = std::chrono::steady_clock::now();
+        switch (options.partitioner) {
+            case SweepPartitioner::Placement:
+                partitions = improvedTreePartitioning(variantTree, order, latencyLimit, memoryLimit, linkages, options.policy, &arena);
+                break;
+            case SweepPartitioner::Locality: {
+                // The locality mode walks the tree depth-first itself, so it has no use for the order
+                LocalityOptions locality;
+                locality.policy = options.policy;
+                partitions = localityTreePartitioning(variantTree, latencyLimit, memoryLimit, linkages, locality, &arena);
+                break;
+            }
+            case SweepPartitioner::Minimum:
+                partitions = minimumTreePartitioning(variantTree, order, latencyLimit, memoryLimit, linkages, true, &arena);
+                break;
+        }
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::vector<std::int64_t> totalCost(partitions.size()), totalLatency(partitions.size());
+        for (std::size_t f = 0; f < partitions.size(); ++f) {
+            totalCost[f] = partitions[f].totalCost;
+            totalLatency[f] = partitions[f].totalLatency;
+        }
+        const CommunicationTotals traffic = communicationTotals(buildCommunicationGraph(variantTree, partitions, linkages));
+
+        SweepResult& result = results[point];
+        result.latencyLimit = latencyLimit;
+        result.memoryLimit = memoryLimit;
+        result.secureRatio = ratios[variant];
+        result.partitions = partitions.size();
+        result.qos = evaluateQoS(totalCost.data(), totalLatency.data(), partitions.size(), options.qosCostLimit, options.qosLatencyLimit);
+        result.linkages = traffic.linkages;
+        result.partitionPairs = traffic.edges;
+        result.millis = elapsed.count();
+        result.pareto = false;
+    });
+
+    markParetoFront(results);
+    return results;
+}
+
+// Function to set the pareto flag of every result, comparing only results with the same secure ratio
+void markParetoFront(std::vector<SweepResult>& results) {
+    auto dominates = [](const SweepResult& a, const SweepResult& b) {
+        return a.secureRatio == b.secureRatio && a.partitions <= b.partitions && a.linkages <= b.linkages && a.qos >= b.qos
+            && (a.partitions < b.partitions || a.linkages < b.linkages || a.qos > b.qos);
+    };
+    // Grids are small (a few hundred points), so the pairwise test is cheaper than sorting
+    for (SweepResult& candidate : results) {
+        candidate.pareto = std::none_of(results.begin(), results.end(),
+                                        [&](const SweepResult& other) { return dominates(other, candidate); });
+    }
+}
+
+} // namespace sasap
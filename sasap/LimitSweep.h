@@ -0,0 +1,89 @@
+/*
+
+   Sweep of the SASAP limits over one workflow. The tree is built or loaded once; every
+   secure ratio gets a variant of it with the first ratio * n nodes (rounded) marked secure,
+   the convention of generateTree. A variant only owns its secure flags and shares every
+   other column and the child lists with the tree, so one breadth-first order serves the
+   placement and minimum partitioners at every point; the locality mode walks the tree
+   depth-first on its own. The grid of
+   (latency limit, memory limit, secure ratio) points is then partitioned in parallel, each
+   point on one worker in its own arena, and scored by
+
+     partitions   composite functions created (cold starts)
+     qos          mean QoS satisfaction against a fixed service target, so larger limits
+                  trade fewer partitions for functions that overrun the target
+     linkages     linkages between different partitions (remote invocations)
+
+   A point is on the Pareto front when no other point with the same secure ratio (the ratio
+   describes the workload, it is not a knob) has at most as many partitions and linkages and
+   at least the same QoS, and is strictly better in one of them. Results come back in grid
+   order whatever the number of threads.
+
+*/
+
+#ifndef SASAP_LIMIT_SWEEP_H
+#define SASAP_LIMIT_SWEEP_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "PlacementIndex.h"
+#include "WorkflowTree.h"
+
+namespace sasap {
+
+class WorkStealingPool;
+
+// Partitioner evaluated at every grid point
+enum class SweepPartitioner {
+    Placement,   // improvedTreePartitioning
+    Locality,    // localityTreePartitioning
+    Minimum      // minimumTreePartitioning
+};
+
+// Function to parse "placement", "locality" or "minimum" (throws std::invalid_argument otherwise)
+SweepPartitioner parseSweepPartitioner(const std::string& name);
+
+// Function to return the command line name of a sweep partitioner
+const char* sweepPartitionerName(SweepPartitioner partitioner);
+
+// Grid of the sweep; every combination is one point
+struct SweepGrid {
+    std::vector<int> latencyLimits = { 50 };
+    std::vector<int> memoryLimits = { 100 };
+    std::vector<double> secureRatios;   // Empty keeps the tree's own secure flags
+};
+
+struct SweepOptions {
+    SweepPartitioner partitioner = SweepPartitioner::Placement;
+    PlacementPolicy policy = PlacementPolicy::FirstFit;
+    int qosLatencyLimit = 50;    // Service target the QoS of every composite function is scored against
+    int qosCostLimit = 100;
+};
+
+// Outcome of one grid point
+struct SweepResult {
+    int latencyLimit;
+    int memoryLimit;
+    double secureRatio;           // Fraction of secure nodes actually used (the requested ratio after rounding to whole nodes)
+    std::size_t partitions;
+    double qos;
+    std::size_t linkages;         // Linkages between different partitions
+    std::size_t partitionPairs;   // Pairs of partitions that communicate
+    double millis;                // Wall time of the partitioning on its worker
+    bool pareto;
+};
+
+// Function to evaluate every point of the grid on the pool. Throws std::invalid_argument
+// for non-positive limits or secure ratios outside [0, 1].
+std::vector<SweepResult> sweepLimits(const WorkflowTree& tree, const SweepGrid& grid, const SweepOptions& options,
+                                     WorkStealingPool& pool);
+
+// Function to set the pareto flag of every result (fewer partitions, fewer linkages, higher QoS),
+// comparing only results with the same secure ratio
+void markParetoFront(std::vector<SweepResult>& results);
+
+} // namespace sasap
+
+#endif // SASAP_LIMIT_SWEEP_H
@@ -0,0 +1,44 @@
+#include "MemoryUsage.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include <sys/resource.h>
+
+namespace sasap {
+
+// Function to return the peak resident set size of the process in bytes (0 when unavailable)
+std::size_t peakResidentBytes() {
+    // VmHWM follows resetPeakResident(); ru_maxrss only ever grows
+    if (std::FILE* status = std::fopen("/proc/self/status", "r")) {
+        char line[256];
+        std::size_t kilobytes = 0;
+        while (std::fgets(line, sizeof(line), status)) {
+            if (std::strncmp(line, "VmHWM:", 6) == 0) {
+                std::sscanf(line + 6, "%zu", &kilobytes);
+                break;
+            }
+        }
+        std::fclose(status);
+        if (kilobytes > 0) {
+            return kilobytes * 1024;
+        }
+    }
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;   // Kilobytes on Linux
+}
+
+// Function to restart peak tracking from the current resident size
+bool resetPeakResident() {
+    std::FILE* clearRefs = std::fopen("/proc/self/clear_refs", "w");
+    if (!clearRefs) {
+        return false;
+    }
+    bool written = std::fputs("5", clearRefs) >= 0;
+    return std::fclose(clearRefs) == 0 && written;
+}
+
+} // namespace sasap
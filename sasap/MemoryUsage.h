@@ -0,0 +1,23 @@
+/*
+
+   Resident memory measurement for reporting the peak memory of partitioning runs.
+
+*/
+
+#ifndef SASAP_MEMORY_USAGE_H
+#define SASAP_MEMORY_USAGE_H
+
+#include <cstddef>
+
+namespace sasap {
+
+// Function to return the peak resident set size of the process in bytes (0 when unavailable)
+std::size_t peakResidentBytes();
+
+// Function to restart peak tracking from the current resident size, so the next
+// peakResidentBytes() covers only what follows (Linux only; returns false when unsupported)
+bool resetPeakResident();
+
+} // namespace sasap
+
+#endif // SASAP_MEMORY_USAGE_H
@@ -0,0 +1,167 @@
+#include "MinimumPartitioning.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "Profiler.h"
+
+namespace sasap {
+
+namespace {
+
+constexpr std::int64_t kUnlimited = std::numeric_limits<std::int64_t>::max();
+
+// Limits of one cutting pass and how children are ranked: a child's weight is
+// max(cost * costScale, latency * latencyScale)
+struct CutRule {
+    std::int64_t costLimit;
+    std::int64_t latencyLimit;
+    std::int64_t costScale;
+    std::int64_t latencyScale;
+};
+
+// Function to cut the tree bottom-up; cut[v] is 1 when v roots a partition (the tree root
+// always does). Children are settled before their parent by walking order backwards.
+std::vector<std::uint8_t> cutTree(const WorkflowTree& tree, const std::vector<int>& order, const CutRule& rule,
+                                  bool secureRule) {
+    std::vector<std::uint8_t> cut(tree.size(), 0);
+    std::vector<std::uint8_t> oversized(tree.size(), 0);   // Exceeds a limit even without its children
+    std::vector<std::uint8_t> tainted(tree.size(), 0);     // Attached part holds a secure node
+    std::vector<std::int64_t> attachedCost(tree.size());
+    std::vector<std::int64_t> attachedLatency(tree.size());
+    std::vector<std::pair<std::int64_t, int>> heap;        // (weight, child) of the children still attached
+    std::vector<int> stack;
+
+    // Function to make the attached part of a node a partition. Under SASAP's rule a partition
+    // rooted at a non-secure node may not hold secure nodes (a secure node only joins a partition
+    // that already has one), so the topmost secure members are cut off to root partitions of their own.
+    auto close = [&](int node) {
+        cut[node] = 1;
+        if (!secureRule || !tainted[node] || tree.isSecure(node)) {
+            return;
+        }
+        stack.assign(1, node);
+        while (!stack.empty()) {
+            const int v = stack.back();
+            stack.pop_back();
+            for (int child : tree.children(v)) {
+                if (cut[child]) {
+                    continue;
+                }
+                if (tree.isSecure(child)) {
+                    cut[child] = 1;
+                } else {
+                    stack.push_back(child);
+                }
+            }
+        }
+    };
+
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        const int node = *it;
+        std::int64_t cost = tree.cost(node);
+        std::int64_t latency = tree.latency(node);
+        heap.clear();
+        for (int child : tree.children(node)) {
+            if (oversized[child]) {
+                close(child);
+                continue;
+            }
+            cost += attachedCost[child];
+            latency += attachedLatency[child];
+            heap.emplace_back(std::max(attachedCost[child] * rule.costScale, attachedLatency[child] * rule.latencyScale), child);
+        }
+        std::make_heap(heap.begin(), heap.end());
+        while ((cost > rule.costLimit || latency > rule.latencyLimit) && !heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end());
+            const int child = heap.back().second;
+            heap.pop_back();
+            close(child);
+            cost -= attachedCost[child];
+            latency -= attachedLatency[child];
+        }
+        bool secure = tree.isSecure(node);
+        for (const auto& entry : heap) {
+            secure = secure || tainted[entry.second];
+        }
+        tainted[node] = secure;
+        attachedCost[node] = cost;
+        attachedLatency[node] = latency;
+        oversized[node] = cost > rule.costLimit || latency > rule.latencyLimit;
+    }
+    if (!tree.empty()) {
+        close(tree.root());
+    }
+    return cut;
+}
+
+// Function to count the partitions of a cutting pass
+std::size_t countPartitions(const std::vector<std::uint8_t>& cut) {
+    return static_cast<std::size_t>(std::count(cut.begin(), cut.end(), std::uint8_t{1}));
+}
+
+} // namespace
+
+// Function to partition the tree into connected partitions within both limits
+PartitionList minimumTreePartitioning(const WorkflowTree& tree, int latencyLimit, int memoryLimit,
+                                      LinkageList& linkages, bool secureRule,
+                                      std::pmr::memory_resource* resource) {
+    const std::vector<int> order = tree.empty() ? std::vector<int>() : breadthFirstOrder(tree, tree.root());
+    return minimumTreePartitioning(tree, order, latencyLimit, memoryLimit, linkages, secureRule, resource);
+}
+
+// Function to partition the tree given its breadth-first order from the root
+PartitionList minimumTreePartitioning(const WorkflowTree& tree, const std::vector<int>& order,
+                                      int latencyLimit, int memoryLimit, LinkageList& linkages, bool secureRule,
+                                      std::pmr::memory_resource* resource) {
+    SASAP_PROFILE_SCOPE("placement");
+    PartitionList partitions(resource);
+    if (tree.empty()) {
+        return partitions;
+    }
+
+    // Comparing cost * latencyLimit with latency * memoryLimit ranks children by their share of either limit
+    const CutRule rule = { memoryLimit, latencyLimit, std::max(latencyLimit, 1), std::max(memoryLimit, 1) };
+    const std::vector<std::uint8_t> cut = cutTree(tree, order, rule, secureRule);
+
+    // Number the partitions in breadth-first order of their roots; members follow in the same order
+    std::vector<int> partitionOf(tree.size());
+    partitions.reserve(countPartitions(cut));
+    for (int node : order) {
+        if (cut[node]) {
+            partitionOf[node] = static_cast<int>(partitions.size());
+            partitions.push_back({ 0, 0, std::pmr::vector<int>(resource), false });
+            if (node != tree.root()) {
+                linkages.push_back({ tree.parent(node), node });
+            }
+        } else {
+            partitionOf[node] = partitionOf[tree.parent(node)];
+        }
+        Partition& partition = partitions[partitionOf[node]];
+        partition.totalCost += tree.cost(node);
+        partition.totalLatency += tree.latency(node);
+        partition.nodes.push_back(node);
+        partition.hasSecureNode = partition.hasSecureNode || tree.isSecure(node);
+    }
+    SASAP_PROFILE_COUNT("placement.attempts", tree.size());
+    SASAP_PROFILE_COUNT("placement.partitionsCreated", partitions.size());
+    SASAP_PROFILE_COUNT("linkage.emitted", partitions.size() - 1);
+    return partitions;
+}
+
+// Function to return a lower bound on the number of connected partitions within both limits
+std::size_t minimumPartitionLowerBound(const WorkflowTree& tree, int latencyLimit, int memoryLimit) {
+    if (tree.empty()) {
+        return 0;
+    }
+    const std::vector<int> order = breadthFirstOrder(tree, tree.root());
+    const CutRule memoryOnly = { memoryLimit, kUnlimited, 1, 0 };
+    const CutRule latencyOnly = { kUnlimited, latencyLimit, 0, 1 };
+    return std::max(countPartitions(cutTree(tree, order, memoryOnly, false)),
+                    countPartitions(cutTree(tree, order, latencyOnly, false)));
+}
+
+} // namespace sasap
@@ -0,0 +1,62 @@
+/*
+
+   Minimum partitioning into connected pieces of the tree (Kundu and Misra's bottom-up
+   cutting). Nodes are settled children first; every node keeps the part of its subtree that
+   is still attached to it, and while that part exceeds a limit the heaviest attached child
+   is cut off (a max-heap over the children) and becomes the root of a partition of its own.
+   Under a single limit this yields the fewest connected partitions, in O(n log n).
+
+   SASAP's secure placement rule (a secure node only joins a partition that already holds a
+   secure node, a non-secure node joins either kind) means, for a connected partition listed
+   in breadth-first order, that a partition holding a secure node must be rooted at one. With
+   secureRule, a partition that would be rooted at a non-secure node but holds secure nodes
+   has its topmost secure members cut off as partitions of their own; secure nodes and their
+   non-secure descendants may otherwise share a partition. Those extra cuts are not weighed
+   by the heap, so with the rule the result is a feasible partitioning but not necessarily
+   the fewest.
+
+   With both a latency and a memory limit the heaviest child is the one with the largest
+   share of either limit. Minimizing under two limits is NP-hard, so for that case
+   minimumPartitionLowerBound returns the larger of the two exact single-limit minima,
+   ignoring security (no secure rule can need fewer partitions): a partitioning whose size
+   matches it is optimal, and the gap bounds how far it can be off. Only connected partitions
+   are counted; the bin-packing partitioners (SASAP, GrTP) may group unrelated nodes and are
+   not bounded by it.
+
+*/
+
+#ifndef SASAP_MINIMUM_PARTITIONING_H
+#define SASAP_MINIMUM_PARTITIONING_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "SasapPartitioning.h"
+#include "WorkflowTree.h"
+
+namespace sasap {
+
+// Function to partition the tree into connected partitions within both limits, cutting the
+// heaviest children first. Partitions are listed in breadth-first order of their roots with
+// their members in breadth-first order; every cut edge is appended to linkages. A node that
+// alone exceeds a limit gets a partition of its own.
+PartitionList minimumTreePartitioning(const WorkflowTree& tree, int latencyLimit, int memoryLimit,
+                                      LinkageList& linkages, bool secureRule = true,
+                                      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+// Function to partition the tree given its breadth-first order from the root (as returned by
+// breadthFirstOrder), so callers that partition the same tree many times, such as the limit
+// sweep, compute the order once
+PartitionList minimumTreePartitioning(const WorkflowTree& tree, const std::vector<int>& order,
+                                      int latencyLimit, int memoryLimit, LinkageList& linkages, bool secureRule = true,
+                                      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+// Function to return a lower bound on the number of connected partitions within both limits,
+// under any secure rule: the larger of the exact minima under the latency limit alone and the
+// memory limit alone, with security ignored
+std::size_t minimumPartitionLowerBound(const WorkflowTree& tree, int latencyLimit, int memoryLimit);
+
+} // namespace sasap
+
+#endif // SASAP_MINIMUM_PARTITIONING_H
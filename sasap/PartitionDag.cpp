@@ -0,0 +1,87 @@
+#include "PartitionDag.h"
+
+#include <algorithm>
+
+namespace sasap {
+
+namespace {
+
+// Function to lay out an edge list as CSR adjacency lists
+void buildAdjacency(int count, const std::vector<std::pair<int, int>>& edges,
+                    std::vector<int>& offset, std::vector<int>& targets) {
+    offset.assign(count + 1, 0);
+    for (const auto& edge : edges) {
+        ++offset[edge.first + 1];
+    }
+    for (int v = 0; v < count; ++v) {
+        offset[v + 1] += offset[v];
+    }
+    targets.resize(edges.size());
+    std::vector<int> next(offset.begin(), offset.end() - 1);
+    for (const auto& edge : edges) {
+        targets[next[edge.first]++] = edge.second;
+    }
+}
+
+} // namespace
+
+// Function to build the group DAG from partition-level edges (self edges are ignored)
+PartitionDag buildPartitionDag(int partitionCount, const std::vector<std::pair<int, int>>& edges) {
+    std::vector<int> offset, targets;
+    buildAdjacency(partitionCount, edges, offset, targets);
+
+    // Tarjan's algorithm with an explicit stack; components come out in reverse topological order
+    std::vector<int> index(partitionCount, -1), low(partitionCount, 0), component(partitionCount, -1);
+    std::vector<int> stack, callStack, nextEdge(partitionCount, 0);
+    int counter = 0, components = 0;
+    for (int start = 0; start < partitionCount; ++start) {
+        if (index[start] >= 0) {
+            continue;
+        }
+        index[start] = low[start] = counter++;
+        stack.push_back(start);
+        callStack.push_back(start);
+        while (!callStack.empty()) {
+            int v = callStack.back();
+            if (nextEdge[v] < offset[v + 1] - offset[v]) {
+                int w = targets[offset[v] + nextEdge[v]++];
+                if (index[w] < 0) {
+                    index[w] = low[w] = counter++;
+                    stack.push_back(w);
+                    callStack.push_back(w);
+                } else if (component[w] < 0) {
+                    low[v] = std::min(low[v], index[w]);
+                }
+                continue;
+            }
+            callStack.pop_back();
+            if (!callStack.empty()) {
+                low[callStack.back()] = std::min(low[callStack.back()], low[v]);
+            }
+            if (low[v] == index[v]) {
+                int w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    component[w] = components;
+                } while (w != v);
+                ++components;
+            }
+        }
+    }
+
+    PartitionDag dag;
+    dag.groupOf.resize(partitionCount);
+    for (int p = 0; p < partitionCount; ++p) {
+        dag.groupOf[p] = components - 1 - component[p];
+    }
+
+    std::vector<std::pair<int, int>> memberPairs(partitionCount);
+    for (int p = 0; p < partitionCount; ++p) {
+        memberPairs[p] = { dag.groupOf[p], p };
+    }
+    buildAdjacency(components, memberPairs, dag.memberOffset, dag.members);
+    return dag;
+}
+
+} // namespace sasap
@@ -0,0 +1,33 @@
+/*
+
+   Dependency graph between partitions for scheduling their execution. Every linkage from a
+   node in partition a to a node in partition b means b needs data produced by a. Partitions
+   are packed by capacity rather than by subtree, so this graph can contain cycles (a feeds b
+   and b feeds a); its strongly connected components are collapsed into groups that run as a
+   single task, which leaves a DAG. Groups are numbered in topological order, so every edge
+   goes from a lower to a higher group.
+
+*/
+
+#ifndef SASAP_PARTITION_DAG_H
+#define SASAP_PARTITION_DAG_H
+
+#include <utility>
+#include <vector>
+
+namespace sasap {
+
+struct PartitionDag {
+    std::vector<int> groupOf;          // Group of every partition
+    std::vector<int> memberOffset;     // Partitions of group g are members[memberOffset[g] .. memberOffset[g + 1])
+    std::vector<int> members;
+
+    int groupCount() const { return static_cast<int>(memberOffset.size()) - 1; }
+};
+
+// Function to build the group DAG from partition-level edges (self edges are ignored)
+PartitionDag buildPartitionDag(int partitionCount, const std::vector<std::pair<int, int>>& edges);
+
+} // namespace sasap
+
+#endif // SASAP_PARTITION_DAG_H
@@ -0,0 +1,357 @@
+#include "PlacementIndex.h"
+
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+namespace sasap {
+
+namespace {
+
+// Capacity of an unused leaf: no request can fit into it
+const int kNoCapacity = INT_MIN;
+
+} // namespace
+
+// Function to parse "first-fit", "best-fit" or "worst-fit"
+PlacementPolicy parsePlacementPolicy(const std::string& name) {
+    if (name == "first-fit") return PlacementPolicy::FirstFit;
+    if (name == "best-fit") return PlacementPolicy::BestFit;
+    if (name == "worst-fit") return PlacementPolicy::WorstFit;
+    throw std::invalid_argument("unknown placement policy: " + name);
+}
+
+// Function to return the command line name of a placement policy
+const char* placementPolicyName(PlacementPolicy policy) {
+    switch (policy) {
+        case PlacementPolicy::FirstFit: return "first-fit";
+        case PlacementPolicy::BestFit: return "best-fit";
+        case PlacementPolicy::WorstFit: return "worst-fit";
+    }
+    return "unknown";
+}
+
+CapacityIndex::CapacityIndex(int latencyCapacity) {
+    if (latencyCapacity >= 0 && latencyCapacity < kMaxLatencyThresholds) {
+        thresholds_ = latencyCapacity + 1;   // Thresholds 0 .. latencyCapacity
+    }
+}
+
+// Function to append a bin and return its index
+int CapacityIndex::add(int remainingLatency, int remainingMemory) {
+    if (count_ == leafBase_) {
+        grow();
+    }
+    int bin = count_++;
+    binLatency_.push_back(remainingLatency);
+    binMemory_.push_back(remainingMemory);
+    update(bin, remainingLatency, remainingMemory);
+    return bin;
+}
+
+// Function to overwrite the remaining capacity of a bin
+void CapacityIndex::update(int bin, int remainingLatency, int remainingMemory) {
+    binLatency_[bin] = remainingLatency;
+    binMemory_[bin] = remainingMemory;
+
+    int node = leafBase_ + bin;
+    maxLatency_[node] = remainingLatency;
+    maxMemory_[node] = remainingMemory;
+    minMemory_[node] = remainingMemory;
+
+    // Walk towards the root until neither the maxima nor the threshold rows change any more;
+    // below the block level there are no rows, so the walk always reaches the block node
+    bool maximaChanged = true, rowChanged = thresholds_ > 0;
+    for (node /= 2; node >= 1 && (maximaChanged || rowChanged); node /= 2) {
+        if (maximaChanged) {
+            maximaChanged = pull(node);
+        }
+        if (thresholds_ > 0 && node < 2 * blockBase_) {
+            rowChanged = node >= blockBase_ ? rebuildBlockRow(node) : rowChanged && pullRow(node);
+        }
+    }
+}
+
+// Function to double the number of leaves and rebuild the internal nodes
+void CapacityIndex::grow() {
+    int newBase = std::max(kLeafBlock, leafBase_ * 2);
+    std::size_t nodes = 2 * static_cast<std::size_t>(newBase);
+    maxLatency_.assign(nodes, kNoCapacity);
+    maxMemory_.assign(nodes, kNoCapacity);
+    minMemory_.assign(nodes, INT_MAX);
+    leafBase_ = newBase;
+    blockBase_ = newBase / kLeafBlock;
+    fitMemory_.assign(2 * static_cast<std::size_t>(blockBase_) * thresholds_, kNoCapacity);
+
+    for (int bin = 0; bin < count_; ++bin) {
+        int node = newBase + bin;
+        maxLatency_[node] = binLatency_[bin];
+        maxMemory_[node] = binMemory_[bin];
+        minMemory_[node] = binMemory_[bin];
+    }
+    for (int node = newBase - 1; node >= 1; --node) {
+        pull(node);
+    }
+    if (thresholds_ > 0) {
+        for (int node = 2 * blockBase_ - 1; node >= blockBase_; --node) {
+            rebuildBlockRow(node);
+        }
+        for (int node = blockBase_ - 1; node >= 1; --node) {
+            pullRow(node);
+        }
+    }
+}
+
+// Function to recompute the maxima of an internal node from its two children (returns true if they changed)
+bool CapacityIndex::pull(int node) {
+    int left = 2 * node, right = 2 * node + 1;
+    int latency = std::max(maxLatency_[left], maxLatency_[right]);
+    int memory = std::max(maxMemory_[left], maxMemory_[right]);
+    int minMemory = std::min(minMemory_[left], minMemory_[right]);
+    bool changed = latency != maxLatency_[node] || memory != maxMemory_[node] || minMemory != minMemory_[node];
+    maxLatency_[node] = latency;
+    maxMemory_[node] = memory;
+    minMemory_[node] = minMemory;
+    return changed;
+}
+
+// Function to recompute the threshold row of a node above the blocks from its two children
+bool CapacityIndex::pullRow(int node) {
+    std::size_t width = thresholds_;
+    int* row = &fitMemory_[node * width];
+    const int* leftRow = &fitMemory_[2 * node * width];
+    const int* rightRow = &fitMemory_[(2 * node + 1) * width];
+    bool changed = false;
+    for (std::size_t t = 0; t < width; ++t) {
+        int value = std::max(leftRow[t], rightRow[t]);
+        changed |= value != row[t];
+        row[t] = value;
+    }
+    return changed;
+}
+
+// Function to recompute the threshold row of a block node from its bins: each bin raises the
+// entry of its own latency, and a suffix maximum extends it to every lower threshold
+bool CapacityIndex::rebuildBlockRow(int node) {
+    int values[kMaxLatencyThresholds];
+    std::fill(values, values + thresholds_, kNoCapacity);
+    for (int bin = blockBegin(node); bin < blockEnd(node); ++bin) {
+        if (binLatency_[bin] >= 0) {
+            int t = std::min(binLatency_[bin], thresholds_ - 1);
+            values[t] = std::max(values[t], binMemory_[bin]);
+        }
+    }
+    for (int t = thresholds_ - 2; t >= 0; --t) {
+        values[t] = std::max(values[t], values[t + 1]);
+    }
+
+    int* row = &fitMemory_[static_cast<std::size_t>(node) * thresholds_];
+    bool changed = false;
+    for (int t = 0; t < thresholds_; ++t) {
+        changed |= values[t] != row[t];
+        row[t] = values[t];
+    }
+    return changed;
+}
+
+// Function to bound the remaining memory of the bins below a node that have enough latency left
+int CapacityIndex::memoryBound(int node, int latency) const {
+    if (maxLatency_[node] < latency) {
+        return kNoCapacity;
+    }
+    if (thresholds_ > 0 && latency < thresholds_) {
+        return fitMemory_[static_cast<std::size_t>(node) * thresholds_ + std::max(latency, 0)];
+    }
+    return maxMemory_[node];
+}
+
+// Function to test whether some bin below a node may fit (exact when threshold rows are kept)
+bool CapacityIndex::mayFit(int node, int latency, int memory) const {
+    return maxMemory_[node] >= memory && memoryBound(node, latency) >= memory;
+}
+
+// Function to test whether a single bin fits
+bool CapacityIndex::fits(int bin, int latency, int memory) const {
+#ifdef SASAP_ENABLE_PROFILING
+    ++binsScanned_;
+#endif
+    return binLatency_[bin] >= latency && binMemory_[bin] >= memory;
+}
+
+// Function to find a bin with at least the requested capacity (-1 if none fits)
+int CapacityIndex::find(PlacementPolicy policy, int latency, int memory) const {
+    if (count_ == 0) {
+        return -1;
+    }
+    switch (policy) {
+        case PlacementPolicy::FirstFit:
+            return findFirst(1, latency, memory);
+        case PlacementPolicy::BestFit: {
+            int bestBin = -1, bestSlack = INT_MAX;
+            findBest(1, latency, memory, bestBin, bestSlack);
+            return bestBin;
+        }
+        case PlacementPolicy::WorstFit: {
+            int bestBin = -1, bestRemaining = INT_MIN;
+            findWorst(1, latency, memory, bestBin, bestRemaining);
+            return bestBin;
+        }
+    }
+    return -1;
+}
+
+// Leftmost bin that fits: descend left first and backtrack only when the pruning test was inexact
+int CapacityIndex::findFirst(int node, int latency, int memory) const {
+    if (!mayFit(node, latency, memory)) {
+        return -1;
+    }
+    if (thresholds_ > 0 && node >= blockBase_) {
+        for (int bin = blockBegin(node); bin < blockEnd(node); ++bin) {
+            if (fits(bin, latency, memory)) {
+                return bin;
+            }
+        }
+        return -1;
+    }
+    if (node >= leafBase_) {
+        int bin = node - leafBase_;
+        return fits(bin, latency, memory) ? bin : -1;
+    }
+    int bin = findFirst(2 * node, latency, memory);
+    return bin != -1 ? bin : findFirst(2 * node + 1, latency, memory);
+}
+
+// Bin with the smallest memory slack; ties go to the lowest bin
+void CapacityIndex::findBest(int node, int latency, int memory, int& bestBin, int& bestSlack) const {
+    if (!mayFit(node, latency, memory)) {
+        return;
+    }
+    // No bin below can leave less than this much memory unused
+    long long lowerBound = std::max(0LL, static_cast<long long>(minMemory_[node]) - memory);
+    if (lowerBound >= bestSlack) {
+        return;
+    }
+    if (thresholds_ > 0 && node >= blockBase_) {
+        for (int bin = blockBegin(node); bin < blockEnd(node); ++bin) {
+            if (fits(bin, latency, memory) && binMemory_[bin] - memory < bestSlack) {
+                bestBin = bin;
+                bestSlack = binMemory_[bin] - memory;
+            }
+        }
+        return;
+    }
+    if (node >= leafBase_) {
+        int bin = node - leafBase_;
+        if (fits(bin, latency, memory)) {
+            bestBin = bin;
+            bestSlack = binMemory_[bin] - memory;
+        }
+        return;
+    }
+    findBest(2 * node, latency, memory, bestBin, bestSlack);
+    findBest(2 * node + 1, latency, memory, bestBin, bestSlack);
+}
+
+// Bin with the largest remaining memory; ties go to the lowest bin
+void CapacityIndex::findWorst(int node, int latency, int memory, int& bestBin, int& bestRemaining) const {
+    if (!mayFit(node, latency, memory) || memoryBound(node, latency) <= bestRemaining) {
+        return;
+    }
+    if (thresholds_ > 0 && node >= blockBase_) {
+        for (int bin = blockBegin(node); bin < blockEnd(node); ++bin) {
+            if (fits(bin, latency, memory) && binMemory_[bin] > bestRemaining) {
+                bestBin = bin;
+                bestRemaining = binMemory_[bin];
+            }
+        }
+        return;
+    }
+    if (node >= leafBase_) {
+        int bin = node - leafBase_;
+        if (fits(bin, latency, memory)) {
+            bestBin = bin;
+            bestRemaining = binMemory_[bin];
+        }
+        return;
+    }
+    findWorst(2 * node, latency, memory, bestBin, bestRemaining);
+    findWorst(2 * node + 1, latency, memory, bestBin, bestRemaining);
+}
+
+PlacementIndex::PlacementIndex(int latencyLimit, int memoryLimit, PlacementPolicy policy)
+    : latencyLimit_(latencyLimit), memoryLimit_(memoryLimit), policy_(policy),
+      secureIndex_(latencyLimit), openIndex_(latencyLimit) {}
+
+// Function to find the partition that should host a node (-1 if a new partition is needed)
+int PlacementIndex::findPartition(int latency, int memory, bool secure) const {
+    int secureBin = secureIndex_.find(policy_, latency, memory);
+    int securePick = secureBin == -1 ? -1 : securePartition_[secureBin];
+    if (secure) {
+        return securePick;   // Secure nodes only join partitions that already hold secure nodes
+    }
+
+    int openBin = openIndex_.find(policy_, latency, memory);
+    int openPick = openBin == -1 ? -1 : openPartition_[openBin];
+    if (securePick == -1 || openPick == -1) {
+        return securePick == -1 ? openPick : securePick;
+    }
+
+    // Both indexes offer a candidate: apply the policy across them, ties to the older partition
+    int secureMemory = secureIndex_.remainingMemory(secureBin);
+    int openMemory = openIndex_.remainingMemory(openBin);
+    bool preferSecure = securePick < openPick;
+    if (policy_ == PlacementPolicy::BestFit && secureMemory != openMemory) {
+        preferSecure = secureMemory < openMemory;
+    } else if (policy_ == PlacementPolicy::WorstFit && secureMemory != openMemory) {
+        preferSecure = secureMemory > openMemory;
+    }
+    return preferSecure ? securePick : openPick;
+}
+
+// Function to register a newly created partition (identifiers must be 0, 1, 2, ...)
+void PlacementIndex::addPartition(int partition, int usedLatency, int usedMemory, bool secure) {
+    if (partition != static_cast<int>(slots_.size())) {
+        throw std::invalid_argument("PlacementIndex: partitions must be added in creation order");
+    }
+    CapacityIndex& index = secure ? secureIndex_ : openIndex_;
+    int bin = index.add(latencyLimit_ - usedLatency, memoryLimit_ - usedMemory);
+    (secure ? securePartition_ : openPartition_).push_back(partition);
+    slots_.push_back({ secure, bin });
+}
+
+// Function to record the new totals of an existing partition
+void PlacementIndex::updatePartition(int partition, int usedLatency, int usedMemory) {
+    const Slot& slot = slots_[partition];
+    CapacityIndex& index = slot.secure ? secureIndex_ : openIndex_;
+    index.update(slot.bin, latencyLimit_ - usedLatency, memoryLimit_ - usedMemory);
+}
+
+// Function to move a partition between the secure and the non-secure index
+void PlacementIndex::setPartitionSecure(int partition, bool secure) {
+    Slot& slot = slots_[partition];
+    if (slot.secure == secure) {
+        return;
+    }
+    CapacityIndex& from = slot.secure ? secureIndex_ : openIndex_;
+    const int remainingLatency = from.remainingLatency(slot.bin);
+    const int remainingMemory = from.remainingMemory(slot.bin);
+    from.update(slot.bin, kNoCapacity, kNoCapacity);   // No request fits a vacated bin
+    (slot.secure ? freeSecureBins_ : freeOpenBins_).push_back(slot.bin);
+
+    CapacityIndex& to = secure ? secureIndex_ : openIndex_;
+    std::vector<int>& freeBins = secure ? freeSecureBins_ : freeOpenBins_;
+    std::vector<int>& owners = secure ? securePartition_ : openPartition_;
+    int bin;
+    if (freeBins.empty()) {
+        bin = to.add(remainingLatency, remainingMemory);
+        owners.push_back(partition);
+    } else {
+        bin = freeBins.back();
+        freeBins.pop_back();
+        to.update(bin, remainingLatency, remainingMemory);
+        owners[bin] = partition;
+    }
+    slot = { secure, bin };
+}
+
+} // namespace sasap
@@ -0,0 +1,146 @@
+/*
+
+   Indexed bin selection for partition placement. Instead of scanning every partition for
+   each node, the remaining latency and memory capacity of the partitions is kept in a
+   segment tree, so the partition chosen by first-fit, best-fit or worst-fit is found by
+   descending the tree and skipping every subtree that cannot host the node.
+
+*/
+
+#ifndef SASAP_PLACEMENT_INDEX_H
+#define SASAP_PLACEMENT_INDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sasap {
+
+// Rule used to choose among the partitions that can host a node
+enum class PlacementPolicy {
+    FirstFit,   // Earliest created partition that fits
+    BestFit,    // Partition left with the least memory after placement
+    WorstFit    // Partition left with the most memory after placement
+};
+
+// Function to parse "first-fit", "best-fit" or "worst-fit" (throws std::invalid_argument otherwise)
+PlacementPolicy parsePlacementPolicy(const std::string& name);
+
+// Function to return the command line name of a placement policy
+const char* placementPolicyName(PlacementPolicy policy);
+
+// Segment tree over the remaining (latency, memory) capacity of a growing list of bins.
+// When the latency capacity is a small integer range (the usual case, e.g. a limit of 50),
+// every segment tree node also keeps, for each latency threshold t, the largest remaining
+// memory among its bins with at least t latency left. That makes the "does any bin below fit"
+// test exact, so first-fit and worst-fit queries descend straight to their bin in O(log P).
+// Rows are kept only down to blocks of kLeafBlock bins, which are scanned directly; that keeps
+// the rows at a sixteenth of the tree instead of one per node, so millions of bins stay cheap.
+// Larger latency ranges fall back to pruning on the per-dimension maxima only.
+class CapacityIndex {
+public:
+    // Largest latency capacity for which per-threshold rows are kept
+    static constexpr int kMaxLatencyThresholds = 256;
+
+    // Number of consecutive bins summarised by one bottom threshold row
+    static constexpr int kLeafBlock = 16;
+
+    explicit CapacityIndex(int latencyCapacity = -1);
+
+    int size() const { return count_; }
+
+    // Function to append a bin and return its index
+    int add(int remainingLatency, int remainingMemory);
+
+    // Function to overwrite the remaining capacity of a bin
+    void update(int bin, int remainingLatency, int remainingMemory);
+
+    int remainingLatency(int bin) const { return binLatency_[bin]; }
+    int remainingMemory(int bin) const { return binMemory_[bin]; }
+
+    // Function to find a bin with at least the requested capacity (-1 if none fits)
+    int find(PlacementPolicy policy, int latency, int memory) const;
+
+#ifdef SASAP_ENABLE_PROFILING
+    // Number of bins tested one by one by find() so far
+    std::uint64_t binsScanned() const { return binsScanned_; }
+#endif
+
+private:
+    void grow();
+    bool pull(int node);
+    bool pullRow(int node);
+    bool rebuildBlockRow(int node);
+    int blockBegin(int node) const { return (node - blockBase_) * kLeafBlock; }
+    int blockEnd(int node) const { return std::min(blockBegin(node) + kLeafBlock, count_); }
+    bool mayFit(int node, int latency, int memory) const;
+    int memoryBound(int node, int latency) const;
+    bool fits(int bin, int latency, int memory) const;
+    int findFirst(int node, int latency, int memory) const;
+    void findBest(int node, int latency, int memory, int& bestBin, int& bestSlack) const;
+    void findWorst(int node, int latency, int memory, int& bestBin, int& bestRemaining) const;
+
+    int thresholds_ = 0;            // Number of latency thresholds per row (0 when rows are disabled)
+    std::vector<int> fitMemory_;    // Row per node above the leaf blocks: best remaining memory among bins with >= t latency left
+    std::vector<int> maxLatency_;   // Maximum remaining latency per segment tree node
+    std::vector<int> maxMemory_;    // Maximum remaining memory per segment tree node
+    std::vector<int> minMemory_;    // Minimum remaining memory per segment tree node
+    std::vector<int> binLatency_;   // Remaining latency of every bin
+    std::vector<int> binMemory_;    // Remaining memory of every bin
+    int leafBase_ = 0;              // Index of the first leaf (a power of two)
+    int blockBase_ = 0;             // Index of the first node covering one block of kLeafBlock leaves
+    int count_ = 0;                 // Number of bins in use
+#ifdef SASAP_ENABLE_PROFILING
+    mutable std::uint64_t binsScanned_ = 0;
+#endif
+};
+
+// Placement engine for SASAP partitions. Secure and non-secure partitions are indexed
+// separately: a secure node may only join a partition that already holds a secure node,
+// while a non-secure node may join either kind.
+class PlacementIndex {
+public:
+    PlacementIndex(int latencyLimit, int memoryLimit, PlacementPolicy policy = PlacementPolicy::FirstFit);
+
+    PlacementPolicy policy() const { return policy_; }
+
+    // Function to find the partition that should host a node (-1 if a new partition is needed)
+    int findPartition(int latency, int memory, bool secure) const;
+
+    // Function to register a newly created partition (identifiers must be 0, 1, 2, ...)
+    void addPartition(int partition, int usedLatency, int usedMemory, bool secure);
+
+    // Function to record the new totals of an existing partition
+    void updatePartition(int partition, int usedLatency, int usedMemory);
+
+    // Function to move a partition to the secure or the non-secure index when it gains its
+    // first or loses its last secure node; the vacated bin is reused by the next move there
+    void setPartitionSecure(int partition, bool secure);
+
+#ifdef SASAP_ENABLE_PROFILING
+    // Number of partitions tested one by one by findPartition() so far
+    std::uint64_t binsScanned() const { return secureIndex_.binsScanned() + openIndex_.binsScanned(); }
+#endif
+
+private:
+    struct Slot {
+        bool secure;   // Which index holds the partition
+        int bin;       // Position of the partition inside that index
+    };
+
+    int latencyLimit_;
+    int memoryLimit_;
+    PlacementPolicy policy_;
+    CapacityIndex secureIndex_;        // Partitions holding at least one secure node
+    CapacityIndex openIndex_;          // Partitions without secure nodes
+    std::vector<int> securePartition_; // Bin of secureIndex_ -> partition identifier
+    std::vector<int> openPartition_;   // Bin of openIndex_ -> partition identifier
+    std::vector<int> freeSecureBins_;  // Bins of secureIndex_ vacated by setPartitionSecure
+    std::vector<int> freeOpenBins_;    // Bins of openIndex_ vacated by setPartitionSecure
+    std::vector<Slot> slots_;          // Partition identifier -> bin
+};
+
+} // namespace sasap
+
+#endif // SASAP_PLACEMENT_INDEX_H
@@ -0,0 +1,260 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace sasap {
+
+namespace {
+
+// One finished scope
+struct ProfileRecord {
+    const char* name;
+    std::uint64_t startNs;
+    std::uint64_t endNs;
+};
+
+// Running totals of one phase or counter on one thread, keyed by the name literal
+struct PhaseTotals {
+    const char* name;
+    std::uint64_t calls = 0;
+    std::uint64_t totalNs = 0;
+    std::uint64_t minNs = UINT64_MAX;
+    std::uint64_t maxNs = 0;
+};
+
+struct CounterTotal {
+    const char* name;
+    std::uint64_t value;
+};
+
+// Events kept per thread for the trace; totals keep counting once the cap is reached
+constexpr std::size_t kMaxTraceEventsPerThread = std::size_t{1} << 18;
+
+// Buffer owned by one thread while it records and by the registry afterwards
+struct ThreadProfile {
+    unsigned thread = 0;
+    std::vector<ProfileRecord> events;
+    std::vector<PhaseTotals> phases;
+    std::vector<CounterTotal> counters;
+    std::uint64_t droppedEvents = 0;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadProfile>> threads;
+};
+
+// Never destroyed, so threads that outlive main's statics can still record
+Registry& registry() {
+    static Registry* instance = new Registry;
+    return *instance;
+}
+
+// Function to escape a name for a JSON string
+std::string jsonString(const std::string& text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+std::ofstream openOutput(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error(path + ": cannot open for writing");
+    }
+    out << std::fixed << std::setprecision(3);
+    return out;
+}
+
+void closeOutput(std::ofstream& out, const std::string& path) {
+    out.close();
+    if (!out) {
+        throw std::runtime_error(path + ": write failed");
+    }
+}
+
+#ifdef SASAP_ENABLE_PROFILING
+
+thread_local ThreadProfile* currentThread = nullptr;
+
+// Function to return the calling thread's buffer, registering it on first use
+ThreadProfile& threadProfile() {
+    if (currentThread == nullptr) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.threads.push_back(std::make_unique<ThreadProfile>());
+        currentThread = reg.threads.back().get();
+        currentThread->thread = static_cast<unsigned>(reg.threads.size() - 1);
+    }
+    return *currentThread;
+}
+
+#endif
+
+} // namespace
+
+#ifdef SASAP_ENABLE_PROFILING
+
+// Function to return the nanoseconds since the profiler's epoch (the first call in the process)
+std::uint64_t profileClock() {
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+// Function to record a finished scope on the calling thread
+void profileEvent(const char* name, std::uint64_t startNs, std::uint64_t endNs) {
+    ThreadProfile& profile = threadProfile();
+    auto phase = std::find_if(profile.phases.begin(), profile.phases.end(),
+                              [name](const PhaseTotals& totals) { return totals.name == name; });
+    if (phase == profile.phases.end()) {
+        profile.phases.push_back({ name });
+        phase = profile.phases.end() - 1;
+    }
+    std::uint64_t duration = endNs - startNs;
+    ++phase->calls;
+    phase->totalNs += duration;
+    phase->minNs = std::min(phase->minNs, duration);
+    phase->maxNs = std::max(phase->maxNs, duration);
+
+    if (profile.events.size() < kMaxTraceEventsPerThread) {
+        profile.events.push_back({ name, startNs, endNs });
+    } else {
+        ++profile.droppedEvents;
+    }
+}
+
+// Function to add amount to a named counter of the calling thread
+void profileCount(const char* name, std::uint64_t amount) {
+    ThreadProfile& profile = threadProfile();
+    for (CounterTotal& counter : profile.counters) {
+        if (counter.name == name) {
+            counter.value += amount;
+            return;
+        }
+    }
+    profile.counters.push_back({ name, amount });
+}
+
+#endif
+
+// Function to report whether the build records profiles
+bool profilingEnabled() {
+#ifdef SASAP_ENABLE_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Function to write <prefix>.profile.json and <prefix>.trace.json
+void writeProfile(const std::string& prefix) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    // Merge the per-thread totals by name; the same literal may live at different addresses
+    struct PhaseSummary {
+        std::uint64_t calls = 0;
+        std::uint64_t totalNs = 0;
+        std::uint64_t minNs = UINT64_MAX;
+        std::uint64_t maxNs = 0;
+        unsigned threads = 0;
+    };
+    std::map<std::string, PhaseSummary> phases;
+    std::map<std::string, std::uint64_t> counters;
+    std::uint64_t droppedEvents = 0;
+    for (const auto& thread : reg.threads) {
+        for (const PhaseTotals& totals : thread->phases) {
+            PhaseSummary& summary = phases[totals.name];
+            summary.calls += totals.calls;
+            summary.totalNs += totals.totalNs;
+            summary.minNs = std::min(summary.minNs, totals.minNs);
+            summary.maxNs = std::max(summary.maxNs, totals.maxNs);
+            ++summary.threads;
+        }
+        for (const CounterTotal& counter : thread->counters) {
+            counters[counter.name] += counter.value;
+        }
+        droppedEvents += thread->droppedEvents;
+    }
+    std::vector<std::pair<std::string, PhaseSummary>> ranked(phases.begin(), phases.end());
+    std::stable_sort(ranked.begin(), ranked.end(),
+                     [](const auto& a, const auto& b) { return a.second.totalNs > b.second.totalNs; });
+
+    // Summary: phases by total time, then the counters
+    const std::string profilePath = prefix + ".profile.json";
+    std::ofstream profile = openOutput(profilePath);
+    profile << "{\n  \"enabled\": " << (profilingEnabled() ? "true" : "false") << ",\n  \"phases\": [";
+    for (std::size_t i = 0; i < ranked.size(); ++i) {
+        const PhaseSummary& summary = ranked[i].second;
+        profile << (i == 0 ? "\n" : ",\n") << "    {\"name\": " << jsonString(ranked[i].first)
+                << ", \"calls\": " << summary.calls << ", \"threads\": " << summary.threads
+                << ", \"total_ms\": " << summary.totalNs / 1e6 << ", \"mean_ms\": " << summary.totalNs / 1e6 / summary.calls
+                << ", \"min_ms\": " << summary.minNs / 1e6 << ", \"max_ms\": " << summary.maxNs / 1e6 << "}";
+    }
+    profile << (ranked.empty() ? "],\n" : "\n  ],\n") << "  \"counters\": {";
+    std::size_t written = 0;
+    for (const auto& counter : counters) {
+        profile << (written++ == 0 ? "\n" : ",\n") << "    " << jsonString(counter.first) << ": " << counter.second;
+    }
+    profile << (counters.empty() ? "},\n" : "\n  },\n") << "  \"dropped_trace_events\": " << droppedEvents << "\n}\n";
+    closeOutput(profile, profilePath);
+
+    // Trace: one complete ("X") event per scope, timestamps in microseconds
+    const std::string tracePath = prefix + ".trace.json";
+    std::ofstream trace = openOutput(tracePath);
+    trace << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    written = 0;
+    for (const auto& thread : reg.threads) {
+        trace << (written++ == 0 ? "\n" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+              << thread->thread << ", \"args\": {\"name\": \"thread " << thread->thread << "\"}}";
+        for (const ProfileRecord& event : thread->events) {
+            trace << ",\n{\"name\": " << jsonString(event.name) << ", \"cat\": \"sasap\", \"ph\": \"X\", \"pid\": 1, \"tid\": "
+                  << thread->thread << ", \"ts\": " << event.startNs / 1e3 << ", \"dur\": " << (event.endNs - event.startNs) / 1e3 << "}";
+        }
+    }
+    trace << "\n], \"otherData\": {\"counters\": {";
+    written = 0;
+    for (const auto& counter : counters) {
+        trace << (written++ == 0 ? "" : ", ") << jsonString(counter.first) << ": " << counter.second;
+    }
+    trace << "}}}\n";
+    closeOutput(trace, tracePath);
+}
+
+// Function to write the profile under the prefix named by the SASAP_PROFILE environment variable
+std::string writeProfileFromEnvironment() {
+    const char* prefix = std::getenv("SASAP_PROFILE");
+    if (prefix == nullptr || *prefix == '\0') {
+        return std::string();
+    }
+    if (!profilingEnabled()) {
+        std::cerr << "SASAP_PROFILE is set, but this build was compiled without SASAP_ENABLE_PROFILING." << std::endl;
+        return std::string();
+    }
+    try {
+        writeProfile(prefix);
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Profile not written: " << e.what() << std::endl;
+        return std::string();
+    }
+    return prefix;
+}
+
+} // namespace sasap
@@ -0,0 +1,94 @@
+/*
+
+   Hot-path instrumentation. SASAP_PROFILE_SCOPE(name) times the enclosing scope and
+   SASAP_PROFILE_COUNT(name, amount) adds to a named counter. Both compile to nothing unless
+   the whole build defines SASAP_ENABLE_PROFILING (the macro arguments are not even
+   evaluated), so instrumented code costs nothing in normal builds.
+
+   When enabled, every thread appends its scope events and counters to its own buffer, so
+   recording never takes a lock; the buffers outlive their threads and are merged only when
+   the profile is written. Names must be string literals. Phases in use:
+
+     tree.generate, tree.build, tree.load      building the workflow tree
+     traversal.bfs, traversal.split,
+     traversal.leftRight                       traversals and subtree splitting
+     placement, placement.merge,
+     placement.repair                          placing nodes into partitions
+     bicriteria.solve, bicriteria.reconstruct  the bicriteria dynamic program
+     linkage.emit                              creating SASAP's linkage list after placement
+     linkage.aggregate                         building the partition communication graph
+     qos.score                                 QoS scoring
+     deploy                                    simulated deployment
+     sweep.point                               one grid point of the limit sweep
+     output.print                              printing partitions and linkages to the console
+
+   and counters placement.attempts, placement.partitionsCreated, partition.binsScanned (bins
+   the placement index tested one by one), linkage.emitted, linkage.aggregatedEdges, qos.functions and deploy.events.
+
+   Call writeProfileFromEnvironment() once the profiled work has finished: when the
+   SASAP_PROFILE environment variable names an output prefix it writes <prefix>.profile.json
+   (per-phase totals and counters) and <prefix>.trace.json (Chrome trace-event format, for
+   chrome://tracing or Perfetto).
+
+*/
+
+#ifndef SASAP_PROFILER_H
+#define SASAP_PROFILER_H
+
+#include <cstdint>
+#include <string>
+
+namespace sasap {
+
+#ifdef SASAP_ENABLE_PROFILING
+
+// Function to return the nanoseconds since the profiler's epoch (the first call in the process)
+std::uint64_t profileClock();
+
+// Function to record a finished scope on the calling thread
+void profileEvent(const char* name, std::uint64_t startNs, std::uint64_t endNs);
+
+// Function to add amount to a named counter of the calling thread
+void profileCount(const char* name, std::uint64_t amount);
+
+// Timer recording the lifetime of a scope
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : name_(name), start_(profileClock()) {}
+    ~ProfileScope() { profileEvent(name_, start_, profileClock()); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name_;
+    std::uint64_t start_;
+};
+
+#define SASAP_PROFILE_CONCAT_INNER(a, b) a##b
+#define SASAP_PROFILE_CONCAT(a, b) SASAP_PROFILE_CONCAT_INNER(a, b)
+#define SASAP_PROFILE_SCOPE(name) ::sasap::ProfileScope SASAP_PROFILE_CONCAT(sasapProfileScope, __LINE__)(name)
+#define SASAP_PROFILE_COUNT(name, amount) ::sasap::profileCount(name, static_cast<std::uint64_t>(amount))
+
+#else
+
+#define SASAP_PROFILE_SCOPE(name) static_cast<void>(0)
+#define SASAP_PROFILE_COUNT(name, amount) static_cast<void>(0)
+
+#endif
+
+// Function to report whether the build records profiles
+bool profilingEnabled();
+
+// Function to write <prefix>.profile.json and <prefix>.trace.json (throws std::runtime_error
+// when a file cannot be written; writes empty profiles when profiling is compiled out)
+void writeProfile(const std::string& prefix);
+
+// Function to write the profile under the prefix named by the SASAP_PROFILE environment variable.
+// Returns the prefix, or an empty string when nothing was written; a variable that is set in a
+// build without profiling, or a write error, is reported on stderr instead of thrown.
+std::string writeProfileFromEnvironment();
+
+} // namespace sasap
+
+#endif // SASAP_PROFILER_H
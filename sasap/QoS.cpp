@@ -0,0 +1,185 @@
+#include "QoS.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Profiler.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SASAP_QOS_AVX2 1
+#endif
+
+namespace sasap {
+
+// Function to compute the QoS satisfaction (in percent) of one composite function
+double qosSatisfaction(std::int64_t totalCost, std::int64_t totalLatency, int costLimit, int latencyLimit) {
+    if (totalCost <= costLimit && totalLatency <= latencyLimit) {
+        return 100.0;  // Full satisfaction if within limits
+    }
+    // Partial satisfaction based on how much the composite function exceeds the limits
+    double costSatisfaction = (costLimit - totalCost) * 100.0 / costLimit;
+    double latencySatisfaction = (latencyLimit - totalLatency) * 100.0 / latencyLimit;
+    return std::max(0.0, (costSatisfaction + latencySatisfaction) / 2);
+}
+
+// Function to return the 32-bit noise hash of composite function index under seed
+std::uint32_t qosNoiseHash(std::uint32_t seed, std::uint32_t index) {
+    std::uint32_t x = index + seed * 0x9E3779B9u;
+    x ^= x >> 16;
+    x *= 0x21F0AAADu;
+    x ^= x >> 15;
+    x *= 0x735A2D97u;
+    x ^= x >> 15;
+    return x;
+}
+
+namespace {
+
+// Scale from the top 24 bits of the hash to milliseconds; a power-of-two division keeps it exact
+double noiseScale(const QoSNoise& noise) {
+    return noise.spanMs / 16777216.0;
+}
+
+// Function to score one composite function; mirrors the vector kernel operation for operation
+double scoreOne(std::size_t i, const std::int64_t* totalCost, const std::int64_t* totalLatency, double costLimit,
+                double latencyLimit, QoSModel model, const QoSNoise* noise) {
+    double cost = static_cast<double>(totalCost[i]);
+    double latency = static_cast<double>(totalLatency[i]);
+    double costSatisfaction = (costLimit - cost) * 100.0 / costLimit;
+    double latencySatisfaction = (latencyLimit - latency) * 100.0 / latencyLimit;
+    double qos;
+    if (model == QoSModel::Satisfaction) {
+        qos = cost <= costLimit && latency <= latencyLimit ? 100.0 : std::max(0.0, (costSatisfaction + latencySatisfaction) * 0.5);
+    } else {
+        qos = (std::max(0.0, costSatisfaction) + std::max(0.0, latencySatisfaction)) * 0.5;
+    }
+    if (noise != nullptr) {
+        std::uint32_t hash = qosNoiseHash(noise->seed, static_cast<std::uint32_t>(i));
+        double networkLatency = noise->minLatencyMs + std::floor(static_cast<double>(hash >> 8) * noiseScale(*noise));
+        qos = std::max(noise->floor, qos - std::min(networkLatency * noise->impactPerMs, noise->maxImpact));
+    }
+    return qos;
+}
+
+// Function to score [begin, count) with the scalar kernel, accumulating function i into lane i % 4
+void scoreScalar(std::size_t begin, std::size_t count, const std::int64_t* totalCost, const std::int64_t* totalLatency,
+                 double costLimit, double latencyLimit, QoSModel model, const QoSNoise* noise, double* qos, double lanes[4]) {
+    for (std::size_t i = begin; i < count; ++i) {
+        double score = scoreOne(i, totalCost, totalLatency, costLimit, latencyLimit, model, noise);
+        if (qos != nullptr) {
+            qos[i] = score;
+        }
+        lanes[i % 4] += score;
+    }
+}
+
+#ifdef SASAP_QOS_AVX2
+
+// Function to convert four int64 values below 2^51 in magnitude to double exactly
+__attribute__((target("avx2"))) inline __m256d int64ToDouble(__m256i value) {
+    const __m256i magic = _mm256_set1_epi64x(0x4338000000000000LL);   // Bit pattern of 0x1.8p52
+    return _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(value, magic)), _mm256_set1_pd(6755399441055744.0));
+}
+
+// Function to score the first count - count % 4 functions four at a time; returns where it stopped
+__attribute__((target("avx2"))) std::size_t scoreAvx2(std::size_t count, const std::int64_t* totalCost, const std::int64_t* totalLatency,
+                                                       double costLimit, double latencyLimit, QoSModel model, const QoSNoise* noise,
+                                                       double* qos, double lanes[4]) {
+    const __m256d cLimit = _mm256_set1_pd(costLimit);
+    const __m256d lLimit = _mm256_set1_pd(latencyLimit);
+    const __m256d hundred = _mm256_set1_pd(100.0);
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d zero = _mm256_setzero_pd();
+    __m256d sum = _mm256_loadu_pd(lanes);
+
+    // Noise constants; the hash runs on four 32-bit lanes
+    const __m128i seedMix = _mm_set1_epi32(static_cast<int>(noise != nullptr ? noise->seed * 0x9E3779B9u : 0u));
+    const __m128i laneIndex = _mm_setr_epi32(0, 1, 2, 3);
+    const __m128i mul1 = _mm_set1_epi32(static_cast<int>(0x21F0AAADu));
+    const __m128i mul2 = _mm_set1_epi32(static_cast<int>(0x735A2D97u));
+    const __m256d minLatency = _mm256_set1_pd(noise != nullptr ? noise->minLatencyMs : 0);
+    const __m256d scale = _mm256_set1_pd(noise != nullptr ? noiseScale(*noise) : 0.0);
+    const __m256d impactPerMs = _mm256_set1_pd(noise != nullptr ? noise->impactPerMs : 0.0);
+    const __m256d maxImpact = _mm256_set1_pd(noise != nullptr ? noise->maxImpact : 0.0);
+    const __m256d qosFloor = _mm256_set1_pd(noise != nullptr ? noise->floor : 0.0);
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d cost = int64ToDouble(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(totalCost + i)));
+        __m256d latency = int64ToDouble(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(totalLatency + i)));
+        __m256d costSatisfaction = _mm256_div_pd(_mm256_mul_pd(_mm256_sub_pd(cLimit, cost), hundred), cLimit);
+        __m256d latencySatisfaction = _mm256_div_pd(_mm256_mul_pd(_mm256_sub_pd(lLimit, latency), hundred), lLimit);
+        __m256d score;
+        if (model == QoSModel::Satisfaction) {
+            __m256d within = _mm256_and_pd(_mm256_cmp_pd(cost, cLimit, _CMP_LE_OQ), _mm256_cmp_pd(latency, lLimit, _CMP_LE_OQ));
+            __m256d partial = _mm256_max_pd(_mm256_mul_pd(_mm256_add_pd(costSatisfaction, latencySatisfaction), half), zero);
+            score = _mm256_blendv_pd(partial, hundred, within);
+        } else {
+            score = _mm256_mul_pd(_mm256_add_pd(_mm256_max_pd(costSatisfaction, zero), _mm256_max_pd(latencySatisfaction, zero)), half);
+        }
+        if (noise != nullptr) {
+            __m128i x = _mm_add_epi32(_mm_add_epi32(_mm_set1_epi32(static_cast<int>(i)), laneIndex), seedMix);
+            x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+            x = _mm_mullo_epi32(x, mul1);
+            x = _mm_xor_si128(x, _mm_srli_epi32(x, 15));
+            x = _mm_mullo_epi32(x, mul2);
+            x = _mm_xor_si128(x, _mm_srli_epi32(x, 15));
+            __m256d hash = _mm256_cvtepi32_pd(_mm_srli_epi32(x, 8));   // 24 bits, so the signed conversion is exact
+            __m256d networkLatency = _mm256_add_pd(minLatency, _mm256_floor_pd(_mm256_mul_pd(hash, scale)));
+            __m256d impact = _mm256_min_pd(_mm256_mul_pd(networkLatency, impactPerMs), maxImpact);
+            score = _mm256_max_pd(_mm256_sub_pd(score, impact), qosFloor);
+        }
+        if (qos != nullptr) {
+            _mm256_storeu_pd(qos + i, score);
+        }
+        sum = _mm256_add_pd(sum, score);
+    }
+    _mm256_storeu_pd(lanes, sum);
+    return i;
+}
+
+bool cpuHasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+#endif
+
+} // namespace
+
+// Function to score count composite functions given by their totals and return the mean QoS
+double evaluateQoS(const std::int64_t* totalCost, const std::int64_t* totalLatency, std::size_t count,
+                   int costLimit, int latencyLimit, QoSModel model, const QoSNoise* noise, double* qos) {
+    SASAP_PROFILE_SCOPE("qos.score");
+    SASAP_PROFILE_COUNT("qos.functions", count);
+    double lanes[4] = { 0.0, 0.0, 0.0, 0.0 };
+    std::size_t done = 0;
+#ifdef SASAP_QOS_AVX2
+    if (cpuHasAvx2()) {
+        done = scoreAvx2(count, totalCost, totalLatency, costLimit, latencyLimit, model, noise, qos, lanes);
+    }
+#endif
+    scoreScalar(done, count, totalCost, totalLatency, costLimit, latencyLimit, model, noise, qos, lanes);
+    return count > 0 ? ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) / count : 0.0;
+}
+
+// Function to score with the scalar kernel only
+double evaluateQoSScalar(const std::int64_t* totalCost, const std::int64_t* totalLatency, std::size_t count,
+                         int costLimit, int latencyLimit, QoSModel model, const QoSNoise* noise, double* qos) {
+    double lanes[4] = { 0.0, 0.0, 0.0, 0.0 };
+    scoreScalar(0, count, totalCost, totalLatency, costLimit, latencyLimit, model, noise, qos, lanes);
+    return count > 0 ? ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) / count : 0.0;
+}
+
+// Function to return the kernel evaluateQoS dispatches to ("avx2" or "scalar")
+const char* qosKernelName() {
+#ifdef SASAP_QOS_AVX2
+    if (cpuHasAvx2()) {
+        return "avx2";
+    }
+#endif
+    return "scalar";
+}
+
+} // namespace sasap
@@ -0,0 +1,65 @@
+/*
+
+   QoS satisfaction of a composite function with respect to its cost and latency limits,
+   shared by the partitioners and the benchmark harness.
+
+   evaluateQoS scores a whole partitioning at once from structure-of-arrays totals. It uses
+   AVX2 when the CPU supports it and a scalar loop otherwise; both paths perform the same
+   double operations and accumulate in the same four-lane order, so they return identical
+   results. The optional latency noise replaces per-function rand() calls with a seeded
+   32-bit hash of (seed, function index), which vectorizes and is reproducible.
+
+*/
+
+#ifndef SASAP_QOS_H
+#define SASAP_QOS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sasap {
+
+// Function to compute the QoS satisfaction (in percent) of one composite function: full
+// satisfaction within both limits, otherwise the mean relative headroom of cost and latency,
+// floored at zero
+double qosSatisfaction(std::int64_t totalCost, std::int64_t totalLatency, int costLimit, int latencyLimit);
+
+// Scoring rule applied to every composite function
+enum class QoSModel {
+    Satisfaction,   // qosSatisfaction above
+    Headroom        // Mean of the cost and latency headroom, each floored at zero (never reaches 100 inside the limits)
+};
+
+// Simulated network latency subtracted from every composite function's QoS. Function i sees a
+// latency of minLatencyMs plus hash(seed, i) scaled into [0, spanMs); its QoS drops by
+// impactPerMs per ms, at most maxImpact, and never below floor.
+struct QoSNoise {
+    std::uint32_t seed = 0;
+    int minLatencyMs = 10;
+    int spanMs = 91;
+    double impactPerMs = 0.1;
+    double maxImpact = 25.0;
+    double floor = 10.0;
+};
+
+// Function to return the 32-bit noise hash of composite function index under seed
+std::uint32_t qosNoiseHash(std::uint32_t seed, std::uint32_t index);
+
+// Function to score count composite functions given by their totals and return the mean QoS.
+// Per-function scores are written to qos when it is not null; noise may be null.
+double evaluateQoS(const std::int64_t* totalCost, const std::int64_t* totalLatency, std::size_t count,
+                   int costLimit, int latencyLimit, QoSModel model = QoSModel::Satisfaction,
+                   const QoSNoise* noise = nullptr, double* qos = nullptr);
+
+// Function to score like evaluateQoS with the scalar kernel only, whatever the CPU supports
+// (the reference the vector kernel is checked against)
+double evaluateQoSScalar(const std::int64_t* totalCost, const std::int64_t* totalLatency, std::size_t count,
+                         int costLimit, int latencyLimit, QoSModel model = QoSModel::Satisfaction,
+                         const QoSNoise* noise = nullptr, double* qos = nullptr);
+
+// Function to return the kernel evaluateQoS dispatches to ("avx2" or "scalar")
+const char* qosKernelName();
+
+} // namespace sasap
+
+#endif // SASAP_QOS_H
@@ -0,0 +1,103 @@
+/*
+
+   Counter-based random numbers (Philox4x32-10). A random word is a pure function of
+   (seed, stream, position), so there is no hidden shared state: every thread can draw its
+   own values without locking, and a value depends only on where it sits in the stream, never
+   on which thread computed it or in what order. Work split across any number of threads
+   therefore reproduces the serial output bit for bit.
+
+   Bounded integers use a multiply-shift (Lemire) reduction of one 32-bit word, whose bias is
+   below range / 2^32 and which always consumes exactly one word, keeping positions aligned.
+
+*/
+
+#ifndef SASAP_RANDOM_H
+#define SASAP_RANDOM_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+namespace sasap {
+
+// Independent streams drawn from one seed
+enum class RandomStreamId : std::uint32_t {
+    TreeGeneration = 1,   // Node weights and parents of generated trees
+    LatencyJitter = 2,    // Simulated network latency in QoS scoring
+    WorkflowDrift = 3     // Profile changes replayed by incremental re-partitioning
+};
+
+// Function to compute one Philox4x32-10 block: four random words for a 128-bit counter and 64-bit key
+inline std::array<std::uint32_t, 4> philox4x32(std::array<std::uint32_t, 4> counter, std::uint64_t key) {
+    std::uint32_t k0 = static_cast<std::uint32_t>(key);
+    std::uint32_t k1 = static_cast<std::uint32_t>(key >> 32);
+    for (int round = 0; round < 10; ++round) {
+        std::uint64_t p0 = std::uint64_t{0xD2511F53u} * counter[0];
+        std::uint64_t p1 = std::uint64_t{0xCD9E8D57u} * counter[2];
+        counter = { static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ k0, static_cast<std::uint32_t>(p1),
+                    static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ k1, static_cast<std::uint32_t>(p0) };
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+    return counter;
+}
+
+// Function to return the four random words of block number block in a stream
+inline std::array<std::uint32_t, 4> randomBlock(std::uint64_t seed, RandomStreamId stream, std::uint64_t block) {
+    return philox4x32({ static_cast<std::uint32_t>(block), static_cast<std::uint32_t>(block >> 32),
+                        static_cast<std::uint32_t>(stream), 0u }, seed);
+}
+
+// Function to map a random word to [0, bound)
+inline std::uint32_t boundedRandom(std::uint32_t word, std::uint32_t bound) {
+    return static_cast<std::uint32_t>((std::uint64_t{word} * bound) >> 32);
+}
+
+// Function to map a random word to the inclusive range [min, max]
+inline int uniformRandom(std::uint32_t word, int min, int max) {
+    return min + static_cast<int>(boundedRandom(word, static_cast<std::uint32_t>(max - min) + 1u));
+}
+
+// Sequential reader over one stream; cheap to create, so every thread or task keeps its own
+class RandomStream {
+public:
+    RandomStream(std::uint64_t seed, RandomStreamId stream, std::uint64_t position = 0)
+        : seed_(seed), stream_(stream) { seek(position); }
+
+    // Function to move to word number position of the stream
+    void seek(std::uint64_t position) {
+        block_ = position / 4;
+        index_ = static_cast<int>(position % 4);
+        words_ = randomBlock(seed_, stream_, block_);
+    }
+
+    std::uint32_t next() {
+        if (index_ == 4) {
+            words_ = randomBlock(seed_, stream_, ++block_);
+            index_ = 0;
+        }
+        return words_[index_++];
+    }
+
+    std::uint32_t below(std::uint32_t bound) { return boundedRandom(next(), bound); }
+    int uniform(int min, int max) { return uniformRandom(next(), min, max); }
+
+private:
+    std::uint64_t seed_;
+    RandomStreamId stream_;
+    std::uint64_t block_ = 0;
+    int index_ = 0;
+    std::array<std::uint32_t, 4> words_{};
+};
+
+// Function to draw a fresh seed for runs that were not given one (print it to reproduce the run)
+inline std::uint64_t freshSeed() {
+    std::random_device device;
+    std::uint64_t entropy = (std::uint64_t{device()} << 32) ^ device();
+    return entropy ^ static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+} // namespace sasap
+
+#endif // SASAP_RANDOM_H
@@ -0,0 +1,249 @@
+#include "SasapPartitioning.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <utility>
+
+#include "Arena.h"
+#include "Profiler.h"
+#include "SubtreeSplit.h"
+#include "WorkStealingPool.h"
+
+namespace sasap {
+
+namespace {
+
+// Function to create a new partition containing a single node, allocated from resource
+Partition createPartition(const WorkflowTree& tree, int node, std::pmr::memory_resource* resource) {
+    Partition partition = { tree.cost(node), tree.latency(node), std::pmr::vector<int>({node}, resource), tree.isSecure(node) };
+    return partition;
+}
+
+// Function to place the nodes of one traversal order into partitions.
+// The placement index returns the partition the chosen policy would pick from a linear scan
+// (first-fit by default) in O(log P) per node instead of O(P).
+void placeNodes(const WorkflowTree& tree, const std::vector<int>& order, PlacementIndex& index,
+                PartitionList& partitions) {
+    SASAP_PROFILE_SCOPE("placement");
+    SASAP_PROFILE_COUNT("placement.attempts", order.size());
+    [[maybe_unused]] const std::size_t partitionsBefore = partitions.size();
+    for (int node : order) {
+        int nodeCost = tree.cost(node);
+        int nodeLatency = tree.latency(node);
+        bool nodeSecure = tree.isSecure(node);
+
+        // Try to place the current node in an existing partition
+        int target = index.findPartition(nodeLatency, nodeCost, nodeSecure);
+        if (target != -1) {
+            // Update the partition with the current node
+            Partition& partition = partitions[target];
+            partition.totalLatency += nodeLatency;
+            partition.totalCost += nodeCost;
+            partition.nodes.push_back(node);
+            // Totals of a partition that accepted a node are within the limits, so they fit an int
+            index.updatePartition(target, static_cast<int>(partition.totalLatency), static_cast<int>(partition.totalCost));
+        } else {
+            // If the node couldn't be placed in any existing partition, create a new partition
+            Partition new_partition = createPartition(tree, node, partitions.get_allocator().resource());
+            index.addPartition(static_cast<int>(partitions.size()), nodeLatency, nodeCost, new_partition.hasSecureNode);
+            partitions.push_back(std::move(new_partition));
+        }
+    }
+    SASAP_PROFILE_COUNT("placement.partitionsCreated", partitions.size() - partitionsBefore);
+    SASAP_PROFILE_COUNT("partition.binsScanned", index.binsScanned());
+}
+
+// Function to append the edge from every node of the order to each of its children, in order:
+// SASAP reports every parent-child edge as an inter-linkage
+void emitLinkages(const WorkflowTree& tree, const std::vector<int>& order, LinkageList& linkages) {
+    SASAP_PROFILE_SCOPE("linkage.emit");
+    [[maybe_unused]] const std::size_t linkagesBefore = linkages.size();
+    // About one linkage per node; reserving up front avoids regrowing a list whose old
+    // buffers an arena cannot recycle
+    linkages.reserve(linkages.size() + order.size());
+    for (int node : order) {
+        for (int child : tree.children(node)) {
+            linkages.push_back({node, child});
+        }
+    }
+    SASAP_PROFILE_COUNT("linkage.emitted", linkages.size() - linkagesBefore);
+}
+
+} // namespace
+
+// Function to partition the tree nodes based on latency and memory limits
+PartitionList improvedTreePartitioning(const WorkflowTree& tree, int latencyLimit, int memoryLimit,
+                                       LinkageList& linkages, PlacementPolicy policy,
+                                       std::pmr::memory_resource* resource) {
+    // Traverse through the tree nodes in breadth-first order, starting with the root node
+    return improvedTreePartitioning(tree, breadthFirstOrder(tree, tree.root()), latencyLimit, memoryLimit, linkages, policy, resource);
+}
+
+// Function to partition the tree visiting its nodes in the given order
+PartitionList improvedTreePartitioning(const WorkflowTree& tree, const std::vector<int>& order,
+                                       int latencyLimit, int memoryLimit, LinkageList& linkages,
+                                       PlacementPolicy policy, std::pmr::memory_resource* resource) {
+    PartitionList partitions(resource);                         // Vector to store all partitions
+    PlacementIndex index(latencyLimit, memoryLimit, policy);    // Remaining capacity of every partition
+    placeNodes(tree, order, index, partitions);
+    emitLinkages(tree, order, linkages);
+    return partitions;   // Return all partitions created
+}
+
+// Function to return the weighted communication cost of a set of linkages
+double communicationCost(const WorkflowTree& tree, const LinkageList& linkages, double secureEdgeWeight) {
+    double cost = 0.0;
+    for (const Linkage& linkage : linkages) {
+        cost += tree.isSecure(linkage.fromNode) || tree.isSecure(linkage.toNode) ? secureEdgeWeight : 1.0;
+    }
+    return cost;
+}
+
+// Function to partition the tree keeping parents and children together (locality mode)
+PartitionList localityTreePartitioning(const WorkflowTree& tree, int latencyLimit, int memoryLimit,
+                                       LinkageList& linkages, const LocalityOptions& options,
+                                       std::pmr::memory_resource* resource) {
+    SASAP_PROFILE_SCOPE("placement");
+    PartitionList partitions(resource);
+    if (tree.empty()) {
+        return partitions;
+    }
+    PlacementIndex index(latencyLimit, memoryLimit, options.policy);   // Room for leaves that miss their parent's partition
+    std::vector<int> partitionOf(tree.size(), -1);
+
+    // Cost and latency of every subtree, accumulated bottom-up over the breadth-first order.
+    // Only comparisons against the limits matter, so the sums saturate instead of widening.
+    std::vector<int> subtreeCost = tree.costs();
+    std::vector<int> subtreeLatency = tree.latencies();
+    const std::vector<int> order = breadthFirstOrder(tree, tree.root());
+    auto saturatingAdd = [](int a, int b) { return static_cast<int>(std::min<std::int64_t>(std::int64_t{a} + b, INT_MAX)); };
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        int parent = tree.parent(*it);
+        if (parent >= 0) {
+            subtreeCost[parent] = saturatingAdd(subtreeCost[parent], subtreeCost[*it]);
+            subtreeLatency[parent] = saturatingAdd(subtreeLatency[parent], subtreeLatency[*it]);
+        }
+    }
+    // A subtree that would fill a good part of a partition gets a fresh one to grow in
+    auto seedsPartition = [&](int node) {
+        return subtreeCost[node] >= options.seedFraction * memoryLimit || subtreeLatency[node] >= options.seedFraction * latencyLimit;
+    };
+
+    auto open = [&](int node) {
+        partitionOf[node] = static_cast<int>(partitions.size());
+        index.addPartition(partitionOf[node], tree.latency(node), tree.cost(node), tree.isSecure(node));
+        partitions.push_back(createPartition(tree, node, resource));
+    };
+    auto join = [&](int node, int target) {
+        Partition& partition = partitions[target];
+        partition.totalLatency += tree.latency(node);
+        partition.totalCost += tree.cost(node);
+        partition.nodes.push_back(node);
+        index.updatePartition(target, static_cast<int>(partition.totalLatency), static_cast<int>(partition.totalCost));
+        partitionOf[node] = target;
+    };
+    // Same admission rule as the placement index: limits, and secure nodes only in secure partitions
+    auto admits = [&](const Partition& partition, int node) {
+        return partition.totalLatency + tree.latency(node) <= latencyLimit && partition.totalCost + tree.cost(node) <= memoryLimit
+            && (!tree.isSecure(node) || partition.hasSecureNode);
+    };
+
+    open(tree.root());
+    std::vector<int> stack = { tree.root() };   // Nodes whose children still have to be placed
+    std::vector<int> children;
+    while (!stack.empty()) {
+        int node = stack.back();
+        stack.pop_back();
+        const int home = partitionOf[node];
+
+        // Secure edges first: they are the most expensive ones to cut
+        children.clear();
+        for (int child : tree.children(node)) {
+            if (tree.isSecure(node) || tree.isSecure(child)) {
+                children.push_back(child);
+            }
+        }
+        for (int child : tree.children(node)) {
+            if (!tree.isSecure(node) && !tree.isSecure(child)) {
+                children.push_back(child);
+            }
+        }
+
+        for (int child : children) {
+            int target = -1;
+            if (admits(partitions[home], child)) {
+                target = home;
+            } else if (!seedsPartition(child)) {
+                target = index.findPartition(tree.latency(child), tree.cost(child), tree.isSecure(child));
+            }
+            if (target != -1) {
+                join(child, target);
+            } else {
+                open(child);
+            }
+            if (partitionOf[child] != home) {
+                linkages.push_back({ node, child });
+            }
+        }
+
+        // Continue depth-first in the same child order, so every subtree is packed before the next
+        for (auto it = children.rbegin(); it != children.rend(); ++it) {
+            if (tree.childCount(*it) > 0) {
+                stack.push_back(*it);
+            }
+        }
+    }
+    SASAP_PROFILE_COUNT("placement.attempts", tree.size());
+    SASAP_PROFILE_COUNT("placement.partitionsCreated", partitions.size());
+    SASAP_PROFILE_COUNT("linkage.emitted", linkages.size());
+    return partitions;
+}
+
+// Function to partition independent subtrees concurrently
+PartitionList parallelTreePartitioning(const WorkflowTree& tree, int latencyLimit, int memoryLimit,
+                                       LinkageList& linkages, PlacementPolicy policy,
+                                       WorkStealingPool& pool, std::size_t targetTasks,
+                                       std::pmr::memory_resource* resource) {
+    SubtreeSplit split = splitIntoSubtrees(tree, targetTasks);
+
+    // The arena is not thread-safe, so every task fills its own and the merge copies out of it.
+    // An arena takes its first chunk on the first allocation, and the split caps the task count,
+    // so the arenas hold about as much as the partitions themselves.
+    struct SubtreeResult {
+        Arena arena{64 * 1024};
+        PartitionList partitions{&arena};
+        LinkageList linkages{&arena};
+    };
+    std::vector<SubtreeResult> results(split.taskCount() + 1);   // Slot 0 holds the spine
+
+    pool.parallelFor(results.size(), [&](std::size_t task) {
+        PlacementIndex index(latencyLimit, memoryLimit, policy);
+        const std::vector<int> order = task == 0 ? split.spine : taskOrder(tree, split, task - 1);
+        placeNodes(tree, order, index, results[task].partitions);
+        emitLinkages(tree, order, results[task].linkages);
+    });
+
+    // Deterministic merge: spine first, then the tasks in breadth-first order of their roots
+    SASAP_PROFILE_SCOPE("placement.merge");
+    std::size_t partitionCount = 0;
+    std::size_t linkageCount = linkages.size();
+    for (const auto& result : results) {
+        partitionCount += result.partitions.size();
+        linkageCount += result.linkages.size();
+    }
+    PartitionList partitions(resource);
+    partitions.reserve(partitionCount);
+    linkages.reserve(linkageCount);
+    for (const auto& result : results) {
+        for (const Partition& partition : result.partitions) {
+            partitions.push_back({ partition.totalCost, partition.totalLatency,
+                                   std::pmr::vector<int>(partition.nodes.begin(), partition.nodes.end(), resource),
+                                   partition.hasSecureNode });
+        }
+        linkages.insert(linkages.end(), result.linkages.begin(), result.linkages.end());
+    }
+    return partitions;
+}
+
+} // namespace sasap
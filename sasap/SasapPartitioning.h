@@ -0,0 +1,102 @@
+/*
+
+   Security aware partitioning (SASAP). Nodes are visited in breadth-first order and placed
+   into an existing partition that still has room for their latency and memory (cost). A
+   secure node may only join a partition that already holds a secure node, while a non-secure
+   node may join either kind; a node that fits nowhere opens a new partition. Every
+   parent-child edge is reported as a linkage for the deployment stage.
+
+   The locality mode minimizes communication instead: a node joins its parent's partition
+   whenever the limits allow, so partitions are connected pieces of the tree, and only the
+   edges that cross partitions are reported. Secure edges (a secure node at either end) are
+   remote invocations plus encrypted transfers, so they weigh more and are kept inside a
+   partition first.
+
+   Partitions, their member lists and the linkages are pmr containers: pass an Arena to keep
+   a whole run in one region that is released at once.
+
+*/
+
+#ifndef SASAP_SASAP_PARTITIONING_H
+#define SASAP_SASAP_PARTITIONING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "PlacementIndex.h"
+#include "WorkflowTree.h"
+
+namespace sasap {
+
+class WorkStealingPool;
+
+// Define a structure for partitions of nodes
+struct Partition {
+    std::int64_t totalCost;       // Total cost of nodes in the partition
+    std::int64_t totalLatency;    // Total latency of nodes in the partition
+    std::pmr::vector<int> nodes;  // Vector of node identifiers belonging to this partition
+    bool hasSecureNode;           // Flag to indicate if the partition contains secure nodes
+};
+
+// Define a structure to store inter-linkages between partitions
+struct Linkage {
+    int fromNode;
+    int toNode;
+};
+
+using PartitionList = std::pmr::vector<Partition>;
+using LinkageList = std::pmr::vector<Linkage>;
+
+// Function to partition the tree nodes based on latency and memory limits
+// The partitions and their member lists are allocated from resource.
+PartitionList improvedTreePartitioning(const WorkflowTree& tree, int latencyLimit, int memoryLimit,
+                                       LinkageList& linkages,
+                                       PlacementPolicy policy = PlacementPolicy::FirstFit,
+                                       std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+// Function to partition the tree visiting its nodes in the given order (a breadth-first order
+// from the root reproduces the overload above). Lets callers that partition the same tree
+// many times, such as the limit sweep, compute the order once.
+PartitionList improvedTreePartitioning(const WorkflowTree& tree, const std::vector<int>& order,
+                                       int latencyLimit, int memoryLimit, LinkageList& linkages,
+                                       PlacementPolicy policy = PlacementPolicy::FirstFit,
+                                       std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+// Settings of the locality-aware mode
+struct LocalityOptions {
+    double secureEdgeWeight = 2.0;   // Cost of cutting a secure edge relative to a plain one
+    // A node that misses its parent's partition opens a new one when its subtree would fill at
+    // least this fraction of a partition (by cost or latency); lower values cut fewer edges but
+    // open more partitions
+    double seedFraction = 0.5;
+    PlacementPolicy policy = PlacementPolicy::FirstFit;   // Places the other nodes that miss their parent's partition
+};
+
+// Function to return the weighted communication cost of a set of linkages: 1 per plain edge,
+// secureEdgeWeight per edge with a secure node at either end
+double communicationCost(const WorkflowTree& tree, const LinkageList& linkages, double secureEdgeWeight);
+
+// Function to partition the tree keeping parents and children together (locality mode).
+// Nodes are visited depth-first; the children of a node try its partition first, secure
+// edges before plain ones. A child that does not fit opens a new partition for its subtree
+// when the subtree is large (see seedFraction) and otherwise goes wherever the placement
+// policy finds room. Only edges between different partitions are appended to linkages.
+PartitionList localityTreePartitioning(const WorkflowTree& tree, int latencyLimit, int memoryLimit,
+                                       LinkageList& linkages, const LocalityOptions& options = LocalityOptions(),
+                                       std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+// Function to partition independent subtrees concurrently.
+// The tree is split into a spine and at most about targetTasks tasks, each a group of
+// consecutive subtrees; the spine and every task are partitioned on their own, and the results are concatenated in breadth-first order of
+// their roots, so the output depends only on the tree and targetTasks, not on the core count.
+// Every task works in its own arena; only the merged result is allocated from resource.
+PartitionList parallelTreePartitioning(const WorkflowTree& tree, int latencyLimit, int memoryLimit,
+                                       LinkageList& linkages, PlacementPolicy policy,
+                                       WorkStealingPool& pool, std::size_t targetTasks = 256,
+                                       std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+} // namespace sasap
+
+#endif // SASAP_SASAP_PARTITIONING_H
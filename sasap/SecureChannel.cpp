@@ -0,0 +1,189 @@
+#include "SecureChannel.h"
+
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+
+namespace sasap {
+
+namespace {
+
+std::atomic<std::uint64_t> nextChannelId{1};
+
+// Cipher contexts of one thread, kept for the lifetime of the thread
+struct ThreadCipher {
+    EVP_CIPHER_CTX* encrypt = nullptr;
+    EVP_CIPHER_CTX* decrypt = nullptr;
+    std::uint64_t encryptKey = 0;   // Channel whose key is loaded (0 = none)
+    std::uint64_t decryptKey = 0;
+
+    ~ThreadCipher() {
+        EVP_CIPHER_CTX_free(encrypt);
+        EVP_CIPHER_CTX_free(decrypt);
+    }
+};
+
+thread_local ThreadCipher threadCipher;
+
+void check(int status, const char* what) {
+    if (status != 1) {
+        throw std::runtime_error(std::string("SecureChannel: ") + what + " failed");
+    }
+}
+
+// Function to return the thread's context for one direction with the channel's key loaded
+EVP_CIPHER_CTX* contextFor(bool encrypt, std::uint64_t id, const unsigned char* key) {
+    EVP_CIPHER_CTX*& context = encrypt ? threadCipher.encrypt : threadCipher.decrypt;
+    std::uint64_t& loaded = encrypt ? threadCipher.encryptKey : threadCipher.decryptKey;
+    if (!context) {
+        context = EVP_CIPHER_CTX_new();
+        if (!context) {
+            throw std::runtime_error("SecureChannel: cannot allocate cipher context");
+        }
+        loaded = 0;
+    }
+    if (loaded != id) {
+        int status = encrypt ? EVP_EncryptInit_ex(context, EVP_aes_256_gcm(), nullptr, key, nullptr)
+                             : EVP_DecryptInit_ex(context, EVP_aes_256_gcm(), nullptr, key, nullptr);
+        check(status, "key setup");
+        loaded = id;
+    }
+    return context;
+}
+
+std::uint64_t elapsedNanoseconds(std::chrono::steady_clock::time_point since) {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - since).count());
+}
+
+} // namespace
+
+// Function to reserve room for the given number of messages and payload bytes
+void MessageBatch::reserve(std::size_t messages, std::size_t payloadBytes) {
+    buffer_.reserve(messages * kHeaderSize + payloadBytes);
+    frameOffset_.reserve(messages);
+    length_.reserve(messages);
+}
+
+// Function to append a plaintext message and return its index in the batch
+std::size_t MessageBatch::add(const void* data, std::size_t length) {
+    std::size_t offset = buffer_.size();
+    buffer_.resize(offset + kHeaderSize + length);
+    if (length > 0) {
+        std::memcpy(&buffer_[offset + kHeaderSize], data, length);
+    }
+    frameOffset_.push_back(offset);
+    length_.push_back(length);
+    return frameOffset_.size() - 1;
+}
+
+void MessageBatch::clear() {
+    buffer_.clear();
+    frameOffset_.clear();
+    length_.clear();
+}
+
+// Function to create a channel with a fresh random key
+SecureChannel::SecureChannel() : id_(nextChannelId.fetch_add(1)) {
+    check(RAND_bytes(key_.data(), static_cast<int>(key_.size())), "key generation");
+    check(RAND_bytes(reinterpret_cast<unsigned char*>(&noncePrefix_), sizeof(noncePrefix_)), "nonce generation");
+}
+
+SecureChannel::SecureChannel(const std::array<unsigned char, kKeySize>& key)
+    : key_(key), id_(nextChannelId.fetch_add(1)) {
+    check(RAND_bytes(reinterpret_cast<unsigned char*>(&noncePrefix_), sizeof(noncePrefix_)), "nonce generation");
+}
+
+// Nonces are a random 32-bit prefix followed by a 64-bit message counter
+void SecureChannel::fillNonce(unsigned char* nonce) {
+    std::uint64_t counter = nonceCounter_.fetch_add(1, std::memory_order_relaxed);
+    std::memcpy(nonce, &noncePrefix_, sizeof(noncePrefix_));
+    std::memcpy(nonce + sizeof(noncePrefix_), &counter, sizeof(counter));
+}
+
+void SecureChannel::record(std::size_t messages, std::size_t bytes, std::uint64_t nanoseconds) {
+    messages_.fetch_add(messages, std::memory_order_relaxed);
+    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    nanoseconds_.fetch_add(nanoseconds, std::memory_order_relaxed);
+}
+
+void SecureChannel::sealFrame(EVP_CIPHER_CTX* context, unsigned char* data, std::size_t length,
+                              unsigned char* nonce, unsigned char* tag) {
+    fillNonce(nonce);
+    check(EVP_EncryptInit_ex(context, nullptr, nullptr, nullptr, nonce), "nonce setup");
+    int written = 0;
+    if (length > 0) {
+        check(EVP_EncryptUpdate(context, data, &written, data, static_cast<int>(length)), "encryption");
+    }
+    int finalWritten = 0;
+    check(EVP_EncryptFinal_ex(context, data + written, &finalWritten), "encryption");
+    check(EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_GCM_GET_TAG, static_cast<int>(MessageBatch::kTagSize), tag), "tag");
+}
+
+bool SecureChannel::openFrame(EVP_CIPHER_CTX* context, unsigned char* data, std::size_t length,
+                              const unsigned char* nonce, const unsigned char* tag) {
+    check(EVP_DecryptInit_ex(context, nullptr, nullptr, nullptr, nonce), "nonce setup");
+    int written = 0;
+    if (length > 0) {
+        check(EVP_DecryptUpdate(context, data, &written, data, static_cast<int>(length)), "decryption");
+    }
+    check(EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_GCM_SET_TAG, static_cast<int>(MessageBatch::kTagSize),
+                              const_cast<unsigned char*>(tag)), "tag");
+    int finalWritten = 0;
+    return EVP_DecryptFinal_ex(context, data + written, &finalWritten) == 1;
+}
+
+// Function to encrypt one message in place, writing its nonce and tag
+void SecureChannel::seal(unsigned char* data, std::size_t length, unsigned char* nonce, unsigned char* tag) {
+    auto start = std::chrono::steady_clock::now();
+    sealFrame(contextFor(true, id_, key_.data()), data, length, nonce, tag);
+    record(1, length, elapsedNanoseconds(start));
+}
+
+// Function to decrypt one message in place; returns false when authentication fails
+bool SecureChannel::open(unsigned char* data, std::size_t length, const unsigned char* nonce, const unsigned char* tag) {
+    auto start = std::chrono::steady_clock::now();
+    bool authentic = openFrame(contextFor(false, id_, key_.data()), data, length, nonce, tag);
+    record(1, length, elapsedNanoseconds(start));
+    return authentic;
+}
+
+// Function to seal every message of the batch in place
+void SecureChannel::sealBatch(MessageBatch& batch) {
+    auto start = std::chrono::steady_clock::now();
+    EVP_CIPHER_CTX* context = contextFor(true, id_, key_.data());
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        sealFrame(context, batch.payload(i), batch.length(i), batch.nonce(i), batch.tag(i));
+    }
+    record(batch.size(), batch.payloadBytes(), elapsedNanoseconds(start));
+}
+
+// Function to open message i of a sealed batch in place
+bool SecureChannel::openMessage(MessageBatch& batch, std::size_t i) {
+    return open(batch.payload(i), batch.length(i), batch.nonce(i), batch.tag(i));
+}
+
+// Function to open every message of the batch; returns false if any fails authentication
+bool SecureChannel::openBatch(MessageBatch& batch) {
+    auto start = std::chrono::steady_clock::now();
+    EVP_CIPHER_CTX* context = contextFor(false, id_, key_.data());
+    bool authentic = true;
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        authentic = openFrame(context, batch.payload(i), batch.length(i), batch.nonce(i), batch.tag(i)) && authentic;
+    }
+    record(batch.size(), batch.payloadBytes(), elapsedNanoseconds(start));
+    return authentic;
+}
+
+CryptoStats SecureChannel::stats() const {
+    CryptoStats stats;
+    stats.messages = messages_.load();
+    stats.bytes = bytes_.load();
+    stats.nanoseconds = nanoseconds_.load();
+    return stats;
+}
+
+} // namespace sasap
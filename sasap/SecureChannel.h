@@ -0,0 +1,111 @@
+/*
+
+   AES-256-GCM channel for linkage payloads, built on the OpenSSL EVP interface. Every
+   thread keeps one encryption and one decryption context alive and only reloads the key
+   when it switches channels, so sealing a message costs one IV setup plus the cipher pass.
+   Messages are encrypted in place inside a preallocated batch buffer that also holds their
+   nonces and tags; a whole batch is sealed or opened in one call. The channel counts the
+   bytes it processed and the time spent in the cipher, which gives the per-byte crypto
+   cost of a partitioning's secure linkages.
+
+*/
+
+#ifndef SASAP_SECURE_CHANNEL_H
+#define SASAP_SECURE_CHANNEL_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+typedef struct evp_cipher_ctx_st EVP_CIPHER_CTX;
+
+namespace sasap {
+
+// Messages laid out back to back as [nonce | tag | payload] frames in one buffer
+class MessageBatch {
+public:
+    static const std::size_t kNonceSize = 12;
+    static const std::size_t kTagSize = 16;
+    static const std::size_t kHeaderSize = kNonceSize + kTagSize;
+
+    // Function to reserve room for the given number of messages and payload bytes
+    void reserve(std::size_t messages, std::size_t payloadBytes);
+
+    // Function to append a plaintext message and return its index in the batch
+    std::size_t add(const void* data, std::size_t length);
+
+    void clear();
+
+    std::size_t size() const { return frameOffset_.size(); }
+    std::size_t payloadBytes() const { return buffer_.size() - size() * kHeaderSize; }
+
+    unsigned char* payload(std::size_t i) { return &buffer_[frameOffset_[i] + kHeaderSize]; }
+    const unsigned char* payload(std::size_t i) const { return &buffer_[frameOffset_[i] + kHeaderSize]; }
+    std::size_t length(std::size_t i) const { return length_[i]; }
+    unsigned char* nonce(std::size_t i) { return &buffer_[frameOffset_[i]]; }
+    unsigned char* tag(std::size_t i) { return &buffer_[frameOffset_[i] + kNonceSize]; }
+
+private:
+    std::vector<unsigned char> buffer_;
+    std::vector<std::size_t> frameOffset_;
+    std::vector<std::size_t> length_;
+};
+
+// Totals of the work done by a channel
+struct CryptoStats {
+    std::uint64_t messages = 0;
+    std::uint64_t bytes = 0;         // Payload bytes sealed plus payload bytes opened
+    std::uint64_t nanoseconds = 0;   // Time spent inside the cipher calls
+
+    double nanosecondsPerByte() const { return bytes ? static_cast<double>(nanoseconds) / bytes : 0.0; }
+};
+
+class SecureChannel {
+public:
+    static const std::size_t kKeySize = 32;
+
+    // Function to create a channel with a fresh random key
+    SecureChannel();
+    explicit SecureChannel(const std::array<unsigned char, kKeySize>& key);
+
+    SecureChannel(const SecureChannel&) = delete;
+    SecureChannel& operator=(const SecureChannel&) = delete;
+
+    // Function to encrypt one message in place, writing its nonce and tag
+    void seal(unsigned char* data, std::size_t length, unsigned char* nonce, unsigned char* tag);
+
+    // Function to decrypt one message in place; returns false when authentication fails
+    bool open(unsigned char* data, std::size_t length, const unsigned char* nonce, const unsigned char* tag);
+
+    // Function to seal every message of the batch in place
+    void sealBatch(MessageBatch& batch);
+
+    // Function to open message i of a sealed batch in place
+    bool openMessage(MessageBatch& batch, std::size_t i);
+
+    // Function to open every message of the batch; returns false if any fails authentication
+    bool openBatch(MessageBatch& batch);
+
+    CryptoStats stats() const;
+
+private:
+    void fillNonce(unsigned char* nonce);
+    void sealFrame(EVP_CIPHER_CTX* context, unsigned char* data, std::size_t length, unsigned char* nonce, unsigned char* tag);
+    bool openFrame(EVP_CIPHER_CTX* context, unsigned char* data, std::size_t length,
+                   const unsigned char* nonce, const unsigned char* tag);
+    void record(std::size_t messages, std::size_t bytes, std::uint64_t nanoseconds);
+
+    std::array<unsigned char, kKeySize> key_;
+    std::uint64_t id_;                       // Identifies the key loaded in a thread's contexts
+    std::uint32_t noncePrefix_;              // Random per channel; the counter below makes nonces unique
+    std::atomic<std::uint64_t> nonceCounter_{0};
+    std::atomic<std::uint64_t> messages_{0};
+    std::atomic<std::uint64_t> bytes_{0};
+    std::atomic<std::uint64_t> nanoseconds_{0};
+};
+
+} // namespace sasap
+
+#endif // SASAP_SECURE_CHANNEL_H
@@ -0,0 +1,93 @@
+#include "SubtreeSplit.h"
+
+#include <algorithm>
+#include <queue>
+#include <utility>
+
+#include "Profiler.h"
+
+namespace sasap {
+
+// Function to compute the number of nodes in the subtree of every node
+std::vector<int> subtreeSizes(const WorkflowTree& tree) {
+    std::vector<int> sizes(tree.size(), 1);
+    std::vector<int> order = breadthFirstOrder(tree, tree.root());
+    // Children appear after their parent in breadth-first order, so a reverse sweep is bottom-up
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        int parent = tree.parent(*it);
+        if (parent >= 0) {
+            sizes[parent] += sizes[*it];
+        }
+    }
+    return sizes;
+}
+
+// Function to split the tree into roughly targetTasks independent subtrees below a spine
+SubtreeSplit splitIntoSubtrees(const WorkflowTree& tree, std::size_t targetTasks, std::size_t minSubtreeSize) {
+    SASAP_PROFILE_SCOPE("traversal.split");
+    SubtreeSplit split;
+    if (tree.empty()) {
+        return split;
+    }
+
+    const std::vector<int> sizes = subtreeSizes(tree);
+    const std::size_t grain = std::max<std::size_t>({ 1, minSubtreeSize, tree.size() / std::max<std::size_t>(1, targetTasks) });
+    // Opening a subtree costs one spine node; bound the spine so chains stay cheap to split
+    const std::size_t maxSplits = 4 * std::max<std::size_t>(1, targetTasks);
+
+    // Largest candidate first; ties broken by the smaller identifier so the split is deterministic
+    std::priority_queue<std::pair<int, int>> candidates;
+    std::vector<char> onSpine(tree.size(), 0);
+    onSpine[tree.root()] = 1;
+    for (int child : tree.children(tree.root())) {
+        candidates.emplace(sizes[child], -child);
+    }
+    std::size_t splits = 0;
+    while (!candidates.empty() && static_cast<std::size_t>(candidates.top().first) > grain && splits < maxSplits) {
+        int node = -candidates.top().second;
+        candidates.pop();
+        onSpine[node] = 1;
+        ++splits;
+        for (int child : tree.children(node)) {
+            candidates.emplace(sizes[child], -child);
+        }
+    }
+
+    // Breadth-first walk restricted to the spine lists spine nodes and task roots in tree order
+    split.spine.push_back(tree.root());
+    for (std::size_t head = 0; head < split.spine.size(); ++head) {
+        for (int child : tree.children(split.spine[head])) {
+            if (onSpine[child]) {
+                split.spine.push_back(child);
+            } else {
+                split.taskRoots.push_back(child);
+            }
+        }
+    }
+
+    // Group consecutive subtrees until a task holds at least grain nodes, so at most
+    // n / grain + 1 tasks remain however many small subtrees hang off the spine
+    std::size_t taskSize = 0;
+    for (std::size_t i = 0; i < split.taskRoots.size(); ++i) {
+        taskSize += sizes[split.taskRoots[i]];
+        if (taskSize >= grain || i + 1 == split.taskRoots.size()) {
+            split.taskOffset.push_back(static_cast<int>(i + 1));
+            taskSize = 0;
+        }
+    }
+    return split;
+}
+
+// Function to list the nodes of one task in breadth-first order, starting from all of its roots
+std::vector<int> taskOrder(const WorkflowTree& tree, const SubtreeSplit& split, std::size_t task) {
+    std::vector<int> order(split.taskRoots.begin() + split.taskOffset[task], split.taskRoots.begin() + split.taskOffset[task + 1]);
+    // The output vector doubles as the queue, as in breadthFirstOrder
+    for (std::size_t head = 0; head < order.size(); ++head) {
+        for (int child : tree.children(order[head])) {
+            order.push_back(child);
+        }
+    }
+    return order;
+}
+
+} // namespace sasap
@@ -0,0 +1,43 @@
+/*
+
+   Decomposition of a workflow tree into independent subtrees for parallel partitioning.
+   The largest subtree is repeatedly opened up (its root moves onto the "spine" and its
+   children become candidate subtrees) until every subtree is at most n / targetTasks nodes
+   (but never below minSubtreeSize, so small trees are not shredded into tiny partitions).
+   Consecutive subtrees are then grouped into tasks of at least that many nodes, so the
+   hundreds of thousands of leaves below the root of a star make a few hundred tasks, not
+   one task per leaf. The split depends only on the tree and targetTasks, never on the number of threads, so
+   the merged partitioning is identical however many cores run it.
+
+*/
+
+#ifndef SASAP_SUBTREE_SPLIT_H
+#define SASAP_SUBTREE_SPLIT_H
+
+#include <cstddef>
+#include <vector>
+
+#include "WorkflowTree.h"
+
+namespace sasap {
+
+struct SubtreeSplit {
+    std::vector<int> spine;            // Nodes above the subtrees, in breadth-first order (root first)
+    std::vector<int> taskRoots;        // Roots of the independent subtrees, in breadth-first order
+    std::vector<int> taskOffset{0};    // Task t owns the subtrees of taskRoots[taskOffset[t] .. taskOffset[t + 1])
+
+    std::size_t taskCount() const { return taskOffset.size() - 1; }
+};
+
+// Function to compute the number of nodes in the subtree of every node
+std::vector<int> subtreeSizes(const WorkflowTree& tree);
+
+// Function to split the tree into roughly targetTasks independent subtrees below a spine
+SubtreeSplit splitIntoSubtrees(const WorkflowTree& tree, std::size_t targetTasks, std::size_t minSubtreeSize = 4096);
+
+// Function to list the nodes of one task in breadth-first order, starting from all of its roots
+std::vector<int> taskOrder(const WorkflowTree& tree, const SubtreeSplit& split, std::size_t task);
+
+} // namespace sasap
+
+#endif // SASAP_SUBTREE_SPLIT_H
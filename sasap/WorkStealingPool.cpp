@@ -0,0 +1,188 @@
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace sasap {
+
+namespace {
+
+thread_local const WorkStealingPool* currentPool = nullptr;
+thread_local int currentIndex = -1;
+
+} // namespace
+
+// Function to start the workers (0 selects the number of hardware threads)
+WorkStealingPool::WorkStealingPool(unsigned threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned i = 0; i < threads; ++i) {
+        queues_.push_back(std::make_unique<Worker>());
+    }
+    for (unsigned i = 0; i < threads; ++i) {
+        workers_.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    workAvailable_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+// Index of the calling worker thread in its pool, or -1 outside any pool
+int WorkStealingPool::currentWorker() {
+    return currentIndex;
+}
+
+// Function to enqueue a task: on the caller's own queue from a worker, round-robin otherwise
+void WorkStealingPool::submit(std::function<void()> task) {
+    unsigned target = currentPool == this ? static_cast<unsigned>(currentIndex)
+                                          : nextQueue_.fetch_add(1, std::memory_order_relaxed) % size();
+    submitTo(target, std::move(task));
+}
+
+// Function to enqueue a task on a specific worker's queue
+void WorkStealingPool::submitTo(unsigned worker, std::function<void()> task) {
+    pending_.fetch_add(1);
+    {
+        Worker& queue = *queues_[worker % size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.queue.push_back(std::move(task));
+    }
+    {
+        // Publishing under the sleep mutex closes the race with a worker about to sleep
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        queued_.fetch_add(1);
+    }
+    workAvailable_.notify_one();
+}
+
+// Function to pop a task (own queue newest first, then steal oldest) and run it
+bool WorkStealingPool::tryRunOne(int self) {
+    std::function<void()> task;
+    unsigned count = size();
+    for (unsigned k = 0; k < count && !task; ++k) {
+        bool own = self >= 0 && k == 0;
+        unsigned victim = own ? static_cast<unsigned>(self) : (static_cast<unsigned>(std::max(self, 0)) + k) % count;
+        if (self >= 0 && !own && victim == static_cast<unsigned>(self)) {
+            continue;
+        }
+        Worker& queue = *queues_[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.queue.empty()) {
+            continue;
+        }
+        if (own) {
+            task = std::move(queue.queue.back());
+            queue.queue.pop_back();
+        } else {
+            task = std::move(queue.queue.front());
+            queue.queue.pop_front();
+        }
+    }
+    if (!task) {
+        return false;
+    }
+    queued_.fetch_sub(1);
+
+    try {
+        task();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        if (!firstError_) {
+            firstError_ = std::current_exception();
+        }
+    }
+    finishTask();
+    return true;
+}
+
+// Function to account for a finished task and wake waiters when none remain
+void WorkStealingPool::finishTask() {
+    if (pending_.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        allDone_.notify_all();
+    }
+}
+
+void WorkStealingPool::workerLoop(unsigned index) {
+    currentPool = this;
+    currentIndex = static_cast<int>(index);
+    while (true) {
+        if (tryRunOne(static_cast<int>(index))) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        workAvailable_.wait(lock, [this] { return stopping_ || queued_.load() > 0; });
+        if (stopping_ && queued_.load() == 0) {
+            return;
+        }
+    }
+}
+
+// Function to block until the counter reaches zero; the caller helps run tasks unless help is false
+void WorkStealingPool::waitFor(const std::atomic<std::size_t>& remaining, bool help) {
+    int self = currentPool == this ? currentIndex : -1;
+    while (remaining.load() > 0) {
+        if (help && tryRunOne(self)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        allDone_.wait(lock, [&remaining, this, help] { return remaining.load() == 0 || (help && queued_.load() > 0); });
+    }
+}
+
+// Function to block until every submitted task has finished; the caller helps run tasks
+void WorkStealingPool::wait(bool help) {
+    waitFor(pending_, help);
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        std::swap(error, firstError_);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// Function to run body(i) for every i in [0, count) and wait for those calls only
+void WorkStealingPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& body) {
+    // Completion and errors of this call alone, so nested and concurrent calls never wait on each other
+    struct Batch {
+        std::atomic<std::size_t> remaining{0};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    } batch;
+    batch.remaining = count;
+    for (std::size_t i = 0; i < count; ++i) {
+        submit([this, &batch, &body, i] {
+            try {
+                body(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(batch.errorMutex);
+                if (!batch.error) {
+                    batch.error = std::current_exception();
+                }
+            }
+            if (batch.remaining.fetch_sub(1) == 1) {
+                // batch may be gone once the count is zero; only pool members are touched from here on
+                std::lock_guard<std::mutex> lock(sleepMutex_);
+                allDone_.notify_all();
+            }
+        });
+    }
+    waitFor(batch.remaining, true);
+    if (batch.error) {
+        std::rethrow_exception(batch.error);
+    }
+}
+
+} // namespace sasap
@@ -0,0 +1,82 @@
+/*
+
+   Persistent thread pool with one run queue per worker and work stealing. A worker pops
+   the newest task from its own queue (good locality for tasks it spawned itself) and, when
+   that queue is empty, steals the oldest task from another worker's queue.
+
+*/
+
+#ifndef SASAP_WORK_STEALING_POOL_H
+#define SASAP_WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sasap {
+
+class WorkStealingPool {
+public:
+    // Function to start the workers (0 selects the number of hardware threads)
+    explicit WorkStealingPool(unsigned threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Number of workers; read from the queues, which are complete before the first worker starts
+    unsigned size() const { return static_cast<unsigned>(queues_.size()); }
+
+    // Index of the calling worker thread in its pool, or -1 outside any pool
+    static int currentWorker();
+
+    // Function to enqueue a task: on the caller's own queue from a worker, round-robin otherwise
+    void submit(std::function<void()> task);
+
+    // Function to enqueue a task on a specific worker's queue
+    void submitTo(unsigned worker, std::function<void()> task);
+
+    // Function to block until every submitted task has finished; unless help is false the
+    // caller runs queued tasks meanwhile. The first exception thrown by a task is rethrown here.
+    // Waits for the whole pool, so it must not be called from inside a task.
+    void wait(bool help = true);
+
+    // Function to run body(i) for every i in [0, count) and wait for those calls only, running
+    // queued tasks meanwhile. Safe to call from inside a task and from several threads at once;
+    // the first exception thrown by body is rethrown here.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body);
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> queue;
+    };
+
+    void workerLoop(unsigned index);
+    bool tryRunOne(int self);
+    void finishTask();
+    void waitFor(const std::atomic<std::size_t>& remaining, bool help);
+
+    std::vector<std::unique_ptr<Worker>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<std::size_t> pending_{0};     // Submitted but not yet finished tasks
+    std::atomic<std::size_t> queued_{0};      // Tasks sitting in some queue
+    std::atomic<unsigned> nextQueue_{0};
+    std::atomic<bool> stopping_{false};
+    std::mutex sleepMutex_;
+    std::condition_variable workAvailable_;
+    std::condition_variable allDone_;         // Signalled whenever a wait counter reaches zero
+    std::mutex errorMutex_;
+    std::exception_ptr firstError_;
+};
+
+} // namespace sasap
+
+#endif // SASAP_WORK_STEALING_POOL_H
@@ -0,0 +1,396 @@
+#include "WorkflowIO.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Profiler.h"
+
+namespace sasap {
+
+namespace {
+
+const char kBinaryMagic[8] = { 'S', 'A', 'S', 'A', 'P', 'W', 'T', '1' };
+const std::uint32_t kByteOrderMark = 0x01020304;
+const std::size_t kReadBlock = 1 << 20;
+
+// Shortest node line: five one-character fields, four separators and the newline
+const std::size_t kMinLineBytes = 10;
+
+// Header of the binary format; the column arrays follow it directly
+struct BinaryHeader {
+    char magic[8];
+    std::uint32_t byteOrder;    // kByteOrderMark as written by the producing machine
+    std::uint32_t reserved;
+    std::uint64_t nodeCount;
+};
+
+struct FileCloser {
+    void operator()(std::FILE* file) const { std::fclose(file); }
+};
+using FileHandle = std::unique_ptr<std::FILE, FileCloser>;
+
+FileHandle openFile(const std::string& path, const char* mode) {
+    FileHandle file(std::fopen(path.c_str(), mode));
+    if (!file) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    return file;
+}
+
+// Column arrays filled by the text parser, indexed by node identifier
+struct Columns {
+    std::vector<int> cost, latency, parent;
+    std::vector<std::uint8_t> secure, seen;
+    std::size_t maxNodes = 0;   // Identifiers are dense, so none can reach the number of lines the file can hold
+
+    void ensure(std::size_t id) {
+        if (id >= seen.size()) {
+            std::size_t size = std::min(std::max<std::size_t>(id + 1, seen.size() * 2), maxNodes);
+            cost.resize(size);
+            latency.resize(size);
+            parent.resize(size);
+            secure.resize(size);
+            seen.resize(size, 0);
+        }
+    }
+};
+
+// Parser for one line: fields are read in place from the block buffer
+class LineParser {
+public:
+    LineParser(const char* begin, const char* end, const std::string& path, std::size_t line)
+        : cursor_(begin), end_(end), path_(path), line_(line) {}
+
+    long long integer() {
+        skipSeparators();
+        bool negative = cursor_ < end_ && *cursor_ == '-';
+        if (negative || (cursor_ < end_ && *cursor_ == '+')) {
+            ++cursor_;
+        }
+        if (cursor_ == end_ || *cursor_ < '0' || *cursor_ > '9') {
+            fail("expected an integer");
+        }
+        long long value = 0;
+        while (cursor_ < end_ && *cursor_ >= '0' && *cursor_ <= '9') {
+            value = value * 10 + (*cursor_++ - '0');
+            if (value > INT32_MAX + 1LL) {
+                fail("integer out of range");
+            }
+        }
+        return negative ? -value : value;
+    }
+
+    bool flag() {
+        skipSeparators();
+        const char* start = cursor_;
+        while (cursor_ < end_ && !isSeparator(*cursor_)) {
+            ++cursor_;
+        }
+        std::size_t length = cursor_ - start;
+        if ((length == 1 && *start == '1') || (length == 4 && std::strncmp(start, "true", 4) == 0)) {
+            return true;
+        }
+        if ((length == 1 && *start == '0') || (length == 5 && std::strncmp(start, "false", 5) == 0)) {
+            return false;
+        }
+        fail("expected a secure flag (0/1/true/false)");
+        return false;
+    }
+
+    void finish() {
+        skipSeparators();
+        if (cursor_ != end_) {
+            fail("unexpected trailing field");
+        }
+    }
+
+    [[noreturn]] void fail(const char* what) const {
+        throw std::runtime_error(path_ + ":" + std::to_string(line_) + ": " + what);
+    }
+
+private:
+    static bool isSeparator(char c) { return c == ',' || c == ' ' || c == '\t' || c == '\r'; }
+
+    void skipSeparators() {
+        // At most one comma between fields, surrounded by any amount of blanks
+        while (cursor_ < end_ && (*cursor_ == ' ' || *cursor_ == '\t' || *cursor_ == '\r')) {
+            ++cursor_;
+        }
+        if (cursor_ < end_ && *cursor_ == ',') {
+            ++cursor_;
+            while (cursor_ < end_ && (*cursor_ == ' ' || *cursor_ == '\t' || *cursor_ == '\r')) {
+                ++cursor_;
+            }
+        }
+    }
+
+    const char* cursor_;
+    const char* end_;
+    const std::string& path_;
+    std::size_t line_;
+};
+
+// Function to parse one line into the columns (blank, comment and header lines are skipped)
+void parseLine(const char* begin, const char* end, const std::string& path, std::size_t line, Columns& columns) {
+    const char* first = begin;
+    while (first < end && (*first == ' ' || *first == '\t' || *first == '\r')) {
+        ++first;
+    }
+    if (first == end || *first == '#') {
+        return;
+    }
+    // A first line that does not start with a number is a header
+    if (line == 1 && !(*first == '-' || *first == '+' || (*first >= '0' && *first <= '9'))) {
+        return;
+    }
+
+    LineParser parser(first, end, path, line);
+    long long id = parser.integer();
+    long long cost = parser.integer();
+    long long latency = parser.integer();
+    bool secure = parser.flag();
+    long long parent = parser.integer();
+    parser.finish();
+    if (id < 0 || id >= INT32_MAX || cost < INT32_MIN || cost > INT32_MAX || latency < INT32_MIN || latency > INT32_MAX
+        || parent < -1 || parent >= INT32_MAX) {
+        parser.fail("field out of range");
+    }
+    if (static_cast<std::size_t>(id) >= columns.maxNodes) {
+        parser.fail("node identifier exceeds the number of nodes the file can hold");
+    }
+
+    columns.ensure(static_cast<std::size_t>(id));
+    if (columns.seen[id]) {
+        parser.fail("duplicate node identifier");
+    }
+    columns.seen[id] = 1;
+    columns.cost[id] = static_cast<int>(cost);
+    columns.latency[id] = static_cast<int>(latency);
+    columns.secure[id] = secure;
+    columns.parent[id] = static_cast<int>(parent);
+}
+
+// Read-only memory mapping of a whole file
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("cannot open " + path);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot stat " + path);
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ > 0) {
+            data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data_ == MAP_FAILED) {
+                data_ = nullptr;
+                ::close(fd);
+                throw std::runtime_error("cannot map " + path);
+            }
+            ::madvise(data_, size_, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+    }
+    ~MappedFile() {
+        if (data_) {
+            ::munmap(data_, size_);
+        }
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* data() const { return static_cast<const unsigned char*>(data_); }
+    std::size_t size() const { return size_; }
+
+private:
+    void* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+template <typename T>
+std::vector<T> copyColumn(const unsigned char*& cursor, std::size_t count) {
+    std::vector<T> column(count);
+    if (count > 0) {
+        std::memcpy(column.data(), cursor, count * sizeof(T));
+    }
+    cursor += count * sizeof(T);
+    return column;
+}
+
+void writeAll(std::FILE* file, const void* data, std::size_t bytes, const std::string& path) {
+    if (bytes > 0 && std::fwrite(data, 1, bytes, file) != bytes) {
+        throw std::runtime_error("cannot write " + path);
+    }
+}
+
+} // namespace
+
+// Function to load a text workflow description
+WorkflowTree loadWorkflowText(const std::string& path) {
+    FileHandle file = openFile(path, "rb");
+    struct stat info;
+    if (::fstat(::fileno(file.get()), &info) != 0) {
+        throw std::runtime_error("cannot stat " + path);
+    }
+    Columns columns;
+    columns.maxNodes = S_ISREG(info.st_mode) ? (static_cast<std::size_t>(info.st_size) + 1) / kMinLineBytes   // The last line may lack its newline
+                                             : static_cast<std::size_t>(INT32_MAX);
+    std::size_t nodes = 0, line = 0;
+
+    // Blocks are parsed line by line; a partial last line is carried into the next block
+    std::vector<char> buffer(kReadBlock);
+    std::size_t carried = 0;
+    while (true) {
+        if (carried == buffer.size()) {
+            buffer.resize(buffer.size() * 2);   // A single line longer than the block
+        }
+        std::size_t read = std::fread(buffer.data() + carried, 1, buffer.size() - carried, file.get());
+        std::size_t filled = carried + read;
+        bool atEnd = read == 0;
+        const char* begin = buffer.data();
+        const char* end = buffer.data() + filled;
+        while (true) {
+            const char* newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+            if (!newline) {
+                if (!atEnd) {
+                    break;
+                }
+                newline = end;   // Last line without a terminating newline
+                if (begin == end) {
+                    break;
+                }
+            }
+            parseLine(begin, newline, path, ++line, columns);
+            begin = newline == end ? end : newline + 1;
+        }
+        if (atEnd) {
+            break;
+        }
+        carried = end - begin;
+        std::memmove(buffer.data(), begin, carried);
+    }
+    if (std::ferror(file.get())) {
+        throw std::runtime_error("cannot read " + path);
+    }
+
+    // Identifiers must be dense: the highest one seen fixes the node count
+    for (std::size_t id = columns.seen.size(); id > 0; --id) {
+        if (columns.seen[id - 1]) {
+            nodes = id;
+            break;
+        }
+    }
+    for (std::size_t id = 0; id < nodes; ++id) {
+        if (!columns.seen[id]) {
+            throw std::runtime_error(path + ": node " + std::to_string(id) + " is missing");
+        }
+    }
+    columns.cost.resize(nodes);
+    columns.latency.resize(nodes);
+    columns.secure.resize(nodes);
+    columns.parent.resize(nodes);
+
+    try {
+        return WorkflowTree::fromParents(std::move(columns.cost), std::move(columns.latency),
+                                         std::move(columns.secure), std::move(columns.parent));
+    } catch (const std::invalid_argument& e) {
+        throw std::runtime_error(path + ": " + e.what());
+    }
+}
+
+// Function to load a binary workflow tree
+WorkflowTree loadWorkflowBinary(const std::string& path) {
+    MappedFile mapping(path);
+    BinaryHeader header;
+    if (mapping.size() < sizeof(header)) {
+        throw std::runtime_error(path + ": not a binary workflow file");
+    }
+    std::memcpy(&header, mapping.data(), sizeof(header));
+    if (std::memcmp(header.magic, kBinaryMagic, sizeof(kBinaryMagic)) != 0) {
+        throw std::runtime_error(path + ": not a binary workflow file");
+    }
+    if (header.byteOrder != kByteOrderMark) {
+        throw std::runtime_error(path + ": written with a different byte order");
+    }
+    std::uint64_t n = header.nodeCount;
+    if (n > static_cast<std::uint64_t>(INT32_MAX - 1)
+        || mapping.size() != sizeof(header) + n * (3 * sizeof(std::int32_t) + sizeof(std::uint8_t))) {
+        throw std::runtime_error(path + ": truncated or oversized binary workflow file");
+    }
+
+    const unsigned char* cursor = mapping.data() + sizeof(header);
+    std::vector<int> cost = copyColumn<int>(cursor, n);
+    std::vector<int> latency = copyColumn<int>(cursor, n);
+    std::vector<int> parent = copyColumn<int>(cursor, n);
+    std::vector<std::uint8_t> secure = copyColumn<std::uint8_t>(cursor, n);
+    try {
+        return WorkflowTree::fromParents(std::move(cost), std::move(latency), std::move(secure), std::move(parent));
+    } catch (const std::invalid_argument& e) {
+        throw std::runtime_error(path + ": " + e.what());
+    }
+}
+
+// Function to tell a node count argument from a workflow file path
+bool isNodeCount(const std::string& argument) {
+    return !argument.empty() && argument.find_first_not_of("0123456789") == std::string::npos;
+}
+
+// Function to load either format, recognising binary files by their header
+WorkflowTree loadWorkflow(const std::string& path) {
+    SASAP_PROFILE_SCOPE("tree.load");
+    char magic[sizeof(kBinaryMagic)] = {};
+    {
+        FileHandle file = openFile(path, "rb");
+        if (std::fread(magic, 1, sizeof(magic), file.get()) != sizeof(magic)) {
+            return loadWorkflowText(path);
+        }
+    }
+    return std::memcmp(magic, kBinaryMagic, sizeof(kBinaryMagic)) == 0 ? loadWorkflowBinary(path) : loadWorkflowText(path);
+}
+
+// Function to save a tree in the text format
+void saveWorkflowText(const WorkflowTree& tree, const std::string& path) {
+    FileHandle file = openFile(path, "wb");
+    std::fputs("id,cost,latency,secure,parent\n", file.get());
+    for (int id = 0; id < tree.size(); ++id) {
+        std::fprintf(file.get(), "%d,%d,%d,%d,%d\n", id, tree.cost(id), tree.latency(id), tree.isSecure(id) ? 1 : 0, tree.parent(id));
+    }
+    if (std::fflush(file.get()) != 0 || std::ferror(file.get())) {
+        throw std::runtime_error("cannot write " + path);
+    }
+}
+
+// Function to save a tree in the binary format
+void saveWorkflowBinary(const WorkflowTree& tree, const std::string& path) {
+    FileHandle file = openFile(path, "wb");
+    BinaryHeader header = {};
+    std::memcpy(header.magic, kBinaryMagic, sizeof(kBinaryMagic));
+    header.byteOrder = kByteOrderMark;
+    header.nodeCount = static_cast<std::uint64_t>(tree.size());
+
+    writeAll(file.get(), &header, sizeof(header), path);
+    writeAll(file.get(), tree.costs().data(), tree.costs().size() * sizeof(int), path);
+    writeAll(file.get(), tree.latencies().data(), tree.latencies().size() * sizeof(int), path);
+    writeAll(file.get(), tree.parents().data(), tree.parents().size() * sizeof(int), path);
+    writeAll(file.get(), tree.secureFlags().data(), tree.secureFlags().size(), path);
+    if (std::fflush(file.get()) != 0) {
+        throw std::runtime_error("cannot write " + path);
+    }
+}
+
+} // namespace sasap
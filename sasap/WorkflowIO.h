@@ -0,0 +1,48 @@
+/*
+
+   Loading and saving workflow trees.
+
+   Text format: one node per line as "id,cost,latency,secure,parent" (commas, tabs or spaces
+   separate the fields). Identifiers must cover 0 .. n-1 in any order, the root has parent -1,
+   the secure flag is 0/1 or true/false, and lines that are empty or start with '#' are
+   skipped, as is a header line. The file is parsed in large blocks straight into the
+   tree's column arrays, so no per-node objects or strings are created. Since identifiers
+   are dense, an identifier at or above the number of node lines the file could hold is
+   rejected before any memory is reserved for it.
+
+   Binary format: a fixed header followed by the raw column arrays (cost, latency, parent as
+   32-bit integers, then the secure flags), in the byte order of the writing machine. The
+   file is memory-mapped and every column is copied out of the mapping in one pass.
+
+*/
+
+#ifndef SASAP_WORKFLOW_IO_H
+#define SASAP_WORKFLOW_IO_H
+
+#include <string>
+
+#include "WorkflowTree.h"
+
+namespace sasap {
+
+// Function to load a text workflow description (throws std::runtime_error on malformed input)
+WorkflowTree loadWorkflowText(const std::string& path);
+
+// Function to load a binary workflow tree (throws std::runtime_error on malformed input)
+WorkflowTree loadWorkflowBinary(const std::string& path);
+
+// Function to tell a node count argument (all digits) from a workflow file path
+bool isNodeCount(const std::string& argument);
+
+// Function to load either format, recognising binary files by their header
+WorkflowTree loadWorkflow(const std::string& path);
+
+// Function to save a tree in the text format
+void saveWorkflowText(const WorkflowTree& tree, const std::string& path);
+
+// Function to save a tree in the binary format
+void saveWorkflowBinary(const WorkflowTree& tree, const std::string& path);
+
+} // namespace sasap
+
+#endif // SASAP_WORKFLOW_IO_H
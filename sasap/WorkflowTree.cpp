@@ -0,0 +1,341 @@
+#include "WorkflowTree.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "Profiler.h"
+#include "Random.h"
+#include "WorkStealingPool.h"
+
+namespace sasap {
+
+namespace {
+
+// Trees below this size are built serially even when a pool is given
+constexpr std::size_t kParallelBuildThreshold = std::size_t{1} << 18;
+
+// Radix of one counting sort pass over parent identifiers
+constexpr int kDigitBits = 16;
+constexpr std::size_t kDigitCount = std::size_t{1} << kDigitBits;
+
+// Function to check the parent array and fill the CSR child lists serially; returns whether every
+// parent precedes its children
+bool buildChildListsSerial(const std::vector<int>& parent, int& root, std::vector<int>& childOffset,
+                           std::vector<int>& childIds) {
+    const std::size_t n = parent.size();
+    childOffset.assign(n + 1, 0);
+
+    // Count children per parent and locate the root
+    bool parentsFirst = true;   // Every parent precedes its children, as in generated trees
+    for (std::size_t i = 0; i < n; ++i) {
+        int p = parent[i];
+        parentsFirst = parentsFirst && static_cast<std::size_t>(p + 1) <= i;
+        if (p < 0) {
+            if (root != -1) {
+                throw std::invalid_argument("WorkflowTree: more than one root");
+            }
+            root = static_cast<int>(i);
+        } else if (static_cast<std::size_t>(p) >= n || static_cast<std::size_t>(p) == i) {
+            throw std::invalid_argument("WorkflowTree: parent identifier out of range");
+        } else {
+            ++childOffset[p + 1];
+        }
+    }
+    if (n > 0 && root == -1) {
+        throw std::invalid_argument("WorkflowTree: no root node");
+    }
+
+    // Prefix sums turn the counts into CSR offsets, then a stable scatter fills the child array
+    for (std::size_t i = 0; i < n; ++i) {
+        childOffset[i + 1] += childOffset[i];
+    }
+    childIds.resize(n > 0 ? n - 1 : 0);
+    std::vector<int> cursor(childOffset.begin(), childOffset.end() - 1);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (parent[i] >= 0) {
+            childIds[cursor[parent[i]]++] = static_cast<int>(i);
+        }
+    }
+    return parentsFirst;
+}
+
+// Function to do the same with a pool. The child identifiers are sorted by parent with a stable
+// least-significant-digit counting sort (per-block digit histograms, a prefix over (digit, block)
+// and a parallel scatter), which keeps children ascending within each parent exactly like the
+// serial scatter. The offsets are then read off the sorted array: every run boundary writes the
+// offsets of the parents between the previous run and its own.
+bool buildChildListsParallel(const std::vector<int>& parent, int& root, std::vector<int>& childOffset,
+                             std::vector<int>& childIds, WorkStealingPool& pool) {
+    const std::size_t n = parent.size();
+    const std::size_t blocks = std::min<std::size_t>(std::max<std::size_t>(pool.size(), 1) * 4,
+                                                     (n + kDigitCount - 1) / kDigitCount);
+    auto blockBegin = [&](std::size_t block, std::size_t count) { return count * block / blocks; };
+
+    // Validate the parent array block by block; errors are collected and reported in node order
+    struct BlockCheck {
+        std::size_t roots = 0;
+        int root = -1;
+        bool outOfRange = false;
+        bool parentsFirst = true;
+    };
+    std::vector<BlockCheck> checks(blocks);
+    pool.parallelFor(blocks, [&](std::size_t block) {
+        BlockCheck& check = checks[block];
+        for (std::size_t i = blockBegin(block, n), end = blockBegin(block + 1, n); i < end; ++i) {
+            int p = parent[i];
+            check.parentsFirst = check.parentsFirst && static_cast<std::size_t>(p + 1) <= i;
+            if (p < 0) {
+                check.root = check.roots++ == 0 ? static_cast<int>(i) : check.root;
+            } else if (static_cast<std::size_t>(p) >= n || static_cast<std::size_t>(p) == i) {
+                check.outOfRange = true;
+            }
+        }
+    });
+    bool parentsFirst = true;
+    for (const BlockCheck& check : checks) {
+        if (check.roots > 1 || (check.roots == 1 && root != -1)) {
+            throw std::invalid_argument("WorkflowTree: more than one root");
+        }
+        if (check.outOfRange) {
+            throw std::invalid_argument("WorkflowTree: parent identifier out of range");
+        }
+        root = check.roots == 1 ? check.root : root;
+        parentsFirst = parentsFirst && check.parentsFirst;
+    }
+    if (root == -1) {
+        throw std::invalid_argument("WorkflowTree: no root node");
+    }
+
+    // Every node but the root, in ascending order
+    const std::size_t m = n - 1;
+    const std::size_t skip = static_cast<std::size_t>(root);
+    std::vector<int> keys(m);
+    std::vector<int> scratch(m);
+    pool.parallelFor(blocks, [&](std::size_t block) {
+        for (std::size_t k = blockBegin(block, m), end = blockBegin(block + 1, m); k < end; ++k) {
+            keys[k] = static_cast<int>(k < skip ? k : k + 1);
+        }
+    });
+
+    int bits = 1;
+    while (bits < 31 && (std::size_t{1} << bits) < n) {
+        ++bits;
+    }
+    std::vector<int> histogram(blocks * kDigitCount);
+    for (int shift = 0; shift < bits; shift += kDigitBits) {
+        auto digit = [&](int node) { return (static_cast<unsigned>(parent[node]) >> shift) & (kDigitCount - 1); };
+        std::fill(histogram.begin(), histogram.end(), 0);
+        pool.parallelFor(blocks, [&](std::size_t block) {
+            int* counts = histogram.data() + block * kDigitCount;
+            for (std::size_t k = blockBegin(block, m), end = blockBegin(block + 1, m); k < end; ++k) {
+                ++counts[digit(keys[k])];
+            }
+        });
+        // Exclusive prefix in (digit, block) order gives every block its own write cursor per digit
+        int running = 0;
+        for (std::size_t d = 0; d < kDigitCount; ++d) {
+            for (std::size_t block = 0; block < blocks; ++block) {
+                int count = histogram[block * kDigitCount + d];
+                histogram[block * kDigitCount + d] = running;
+                running += count;
+            }
+        }
+        pool.parallelFor(blocks, [&](std::size_t block) {
+            int* cursor = histogram.data() + block * kDigitCount;
+            for (std::size_t k = blockBegin(block, m), end = blockBegin(block + 1, m); k < end; ++k) {
+                scratch[cursor[digit(keys[k])]++] = keys[k];
+            }
+        });
+        keys.swap(scratch);
+    }
+
+    // Parents without children share the offset of the next run; the last run's successors end at m
+    childOffset.resize(n + 1);
+    pool.parallelFor(blocks, [&](std::size_t block) {
+        for (std::size_t k = blockBegin(block, m), end = blockBegin(block + 1, m); k < end; ++k) {
+            int current = parent[keys[k]];
+            int previous = k == 0 ? -1 : parent[keys[k - 1]];
+            for (int p = previous + 1; p <= current; ++p) {
+                childOffset[p] = static_cast<int>(k);
+            }
+        }
+    });
+    for (std::size_t p = static_cast<std::size_t>(m > 0 ? parent[keys[m - 1]] + 1 : 0); p <= n; ++p) {
+        childOffset[p] = static_cast<int>(m);
+    }
+    childIds = std::move(keys);
+    return parentsFirst;
+}
+
+} // namespace
+
+// Function to return the structure of the empty tree
+std::shared_ptr<const WorkflowTree::Structure> WorkflowTree::emptyStructure() {
+    static const std::shared_ptr<const Structure> empty = std::make_shared<const Structure>();
+    return empty;
+}
+
+// Function to return the same tree with other secure flags, sharing the other columns
+WorkflowTree WorkflowTree::withSecureFlags(std::vector<std::uint8_t> secure) const {
+    if (secure.size() != secure_.size()) {
+        throw std::invalid_argument("WorkflowTree: attribute arrays must have one entry per node");
+    }
+    WorkflowTree tree;
+    tree.structure_ = structure_;
+    tree.secure_ = std::move(secure);
+    return tree;
+}
+
+// Function to build a tree from per-node attributes and a parent array (-1 marks the root)
+WorkflowTree WorkflowTree::fromParents(std::vector<int> cost, std::vector<int> latency,
+                                       std::vector<std::uint8_t> secure, std::vector<int> parent,
+                                       WorkStealingPool* pool) {
+    SASAP_PROFILE_SCOPE("tree.build");
+    const std::size_t n = parent.size();
+    if (cost.size() != n || latency.size() != n || secure.size() != n) {
+        throw std::invalid_argument("WorkflowTree: attribute arrays must have one entry per node");
+    }
+    if (n > static_cast<std::size_t>(INT32_MAX - 1)) {
+        throw std::invalid_argument("WorkflowTree: too many nodes");
+    }
+
+    auto structure = std::make_shared<Structure>();
+    bool parentsFirst = pool != nullptr && n >= kParallelBuildThreshold
+                            ? buildChildListsParallel(parent, structure->root, structure->childOffset, structure->childIds, *pool)
+                            : buildChildListsSerial(parent, structure->root, structure->childOffset, structure->childIds);
+
+    structure->cost = std::move(cost);
+    structure->latency = std::move(latency);
+    structure->parent = std::move(parent);
+    WorkflowTree tree;
+    tree.structure_ = std::move(structure);
+    tree.secure_ = std::move(secure);
+
+    // Every node must be reachable from the root, otherwise the parent array contains a cycle.
+    // When parents precede their children every chain of parents strictly descends to the root,
+    // so the traversal is only needed for arbitrarily numbered trees.
+    if (n > 0 && !parentsFirst && breadthFirstOrder(tree, tree.root()).size() != n) {
+        throw std::invalid_argument("WorkflowTree: parent array contains a cycle");
+    }
+    return tree;
+}
+
+// Function to parse a tree shape name (throws std::invalid_argument otherwise)
+TreeShape parseTreeShape(const std::string& name) {
+    for (TreeShape shape : { TreeShape::Random, TreeShape::Chain, TreeShape::Star, TreeShape::Binary,
+                             TreeShape::KAry, TreeShape::Caterpillar, TreeShape::PowerLaw }) {
+        if (name == treeShapeName(shape)) {
+            return shape;
+        }
+    }
+    throw std::invalid_argument("unknown tree shape: " + name);
+}
+
+// Function to return the command line name of a tree shape
+const char* treeShapeName(TreeShape shape) {
+    switch (shape) {
+    case TreeShape::Random: return "random";
+    case TreeShape::Chain: return "chain";
+    case TreeShape::Star: return "star";
+    case TreeShape::Binary: return "binary";
+    case TreeShape::KAry: return "kary";
+    case TreeShape::Caterpillar: return "caterpillar";
+    case TreeShape::PowerLaw: return "powerlaw";
+    }
+    return "unknown";
+}
+
+namespace {
+
+// Function to return the parent of node i > 0 under the copying model: with word 3 even, node i
+// attaches to the uniform earlier node t drawn from word 2; otherwise it copies t's parent,
+// which is resolved the same way from t's own block. Each step continues with probability 1/2,
+// so the walk is short, and it only reads random blocks, so nodes can be resolved in any order.
+int powerLawParent(std::uint64_t seed, int i, const std::array<std::uint32_t, 4>& words) {
+    int target = static_cast<int>(boundedRandom(words[2], static_cast<std::uint32_t>(i)));
+    if ((words[3] & 1u) == 0) {
+        return target;
+    }
+    while (target != 0) {   // The root has no parent to copy, so copying it attaches to the root
+        std::array<std::uint32_t, 4> next = randomBlock(seed, RandomStreamId::TreeGeneration, static_cast<std::uint64_t>(target));
+        int nextTarget = static_cast<int>(boundedRandom(next[2], static_cast<std::uint32_t>(target)));
+        if ((next[3] & 1u) == 0) {
+            return nextTarget;
+        }
+        target = nextTarget;
+    }
+    return 0;
+}
+
+} // namespace
+
+// Function to generate a tree of the given shape from a seed, optionally in parallel
+WorkflowTree generateTree(int numNodes, int secureNodeCount, WeightRange cost, WeightRange latency, std::uint64_t seed,
+                          TreeShape shape, WorkStealingPool* pool) {
+    SASAP_PROFILE_SCOPE("tree.generate");
+    std::vector<int> costs(numNodes);
+    std::vector<int> latencies(numNodes);
+    std::vector<std::uint8_t> secure(numNodes);
+    std::vector<int> parents(numNodes);
+
+    // Node i only reads its own random block, so any split of the nodes yields the same tree
+    auto fill = [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            std::array<std::uint32_t, 4> words = randomBlock(seed, RandomStreamId::TreeGeneration, static_cast<std::uint64_t>(i));
+            costs[i] = uniformRandom(words[0], cost.min, cost.max);
+            latencies[i] = uniformRandom(words[1], latency.min, latency.max);
+            secure[i] = i < secureNodeCount;
+            if (i == 0) {
+                parents[i] = -1;
+                continue;
+            }
+            switch (shape) {
+            case TreeShape::Random: parents[i] = static_cast<int>(boundedRandom(words[2], static_cast<std::uint32_t>(i))); break;
+            case TreeShape::Chain: parents[i] = i - 1; break;
+            case TreeShape::Star: parents[i] = 0; break;
+            case TreeShape::Binary: parents[i] = (i - 1) / 2; break;
+            case TreeShape::KAry: parents[i] = (i - 1) / kTreeArity; break;
+            case TreeShape::Caterpillar: {
+                int spine = i - i % (kCaterpillarLegs + 1);
+                parents[i] = spine == i ? i - (kCaterpillarLegs + 1) : spine;
+                break;
+            }
+            case TreeShape::PowerLaw: parents[i] = powerLawParent(seed, i, words); break;
+            }
+        }
+    };
+
+    const int blockSize = 1 << 16;
+    const int blocks = (numNodes + blockSize - 1) / blockSize;
+    if (pool != nullptr && blocks > 1) {
+        pool->parallelFor(blocks, [&](std::size_t block) {
+            int begin = static_cast<int>(block) * blockSize;
+            fill(begin, std::min(numNodes, begin + blockSize));
+        });
+    } else {
+        fill(0, numNodes);
+    }
+
+    return WorkflowTree::fromParents(std::move(costs), std::move(latencies), std::move(secure), std::move(parents), pool);
+}
+
+// Function to list the nodes of the subtree rooted at start in breadth-first order
+std::vector<int> breadthFirstOrder(const WorkflowTree& tree, int start) {
+    SASAP_PROFILE_SCOPE("traversal.bfs");
+    std::vector<int> order;
+    if (start < 0 || start >= tree.size()) {
+        return order;
+    }
+    order.push_back(start);
+    // The output vector doubles as the queue: head walks over the nodes already discovered
+    for (std::size_t head = 0; head < order.size(); ++head) {
+        for (int child : tree.children(order[head])) {
+            order.push_back(child);
+        }
+    }
+    return order;
+}
+
+} // namespace sasap
@@ -0,0 +1,140 @@
+/*
+
+   Shared workflow tree used by all partitioning approaches (SASAP, GrTP, LRTP, BiFPTAS).
+   Nodes are stored as a structure of arrays: every per-node attribute lives in its own
+   contiguous array indexed by the node identifier, and the child lists are kept in
+   compressed sparse row (CSR) form, so a lookup by id is a single array access. A tree is
+   immutable once built, so copies share every column but the secure flags; a variant with
+   other secure flags costs one byte per node.
+
+*/
+
+#ifndef SASAP_WORKFLOW_TREE_H
+#define SASAP_WORKFLOW_TREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sasap {
+
+// Contiguous range of child identifiers inside the CSR child array
+struct ChildRange {
+    const int* first;
+    const int* last;
+
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    std::size_t size() const { return static_cast<std::size_t>(last - first); }
+    bool empty() const { return first == last; }
+    int operator[](std::size_t i) const { return first[i]; }
+};
+
+// Inclusive range used when drawing random node weights
+struct WeightRange {
+    int min;
+    int max;
+};
+
+class WorkStealingPool;
+
+// Structure-of-arrays workflow tree. Node identifiers are dense in [0, size()).
+class WorkflowTree {
+public:
+    WorkflowTree() = default;
+
+    // Function to build a tree from per-node attributes and a parent array (-1 marks the root).
+    // With a pool, large trees are validated and their child lists built in parallel; the
+    // result is identical either way.
+    static WorkflowTree fromParents(std::vector<int> cost, std::vector<int> latency,
+                                    std::vector<std::uint8_t> secure, std::vector<int> parent,
+                                    WorkStealingPool* pool = nullptr);
+
+    // Function to return the same tree with other secure flags; the other columns and the
+    // child lists are shared, not copied. Throws std::invalid_argument unless there is one
+    // flag per node.
+    WorkflowTree withSecureFlags(std::vector<std::uint8_t> secure) const;
+
+    int size() const { return static_cast<int>(secure_.size()); }
+    bool empty() const { return secure_.empty(); }
+    int root() const { return structure_->root; }
+
+    int cost(int id) const { return structure_->cost[id]; }
+    int latency(int id) const { return structure_->latency[id]; }
+    bool isSecure(int id) const { return secure_[id] != 0; }
+    int parent(int id) const { return structure_->parent[id]; }
+
+    ChildRange children(int id) const {
+        const int* base = structure_->childIds.data();
+        const int* offset = structure_->childOffset.data();
+        return { base + offset[id], base + offset[id + 1] };
+    }
+    int childCount(int id) const { return structure_->childOffset[id + 1] - structure_->childOffset[id]; }
+
+    // Raw column access for bulk kernels
+    const std::vector<int>& costs() const { return structure_->cost; }
+    const std::vector<int>& latencies() const { return structure_->latency; }
+    const std::vector<std::uint8_t>& secureFlags() const { return secure_; }
+    const std::vector<int>& parents() const { return structure_->parent; }
+    const std::vector<int>& childOffsets() const { return structure_->childOffset; }
+    const std::vector<int>& childIds() const { return structure_->childIds; }
+
+private:
+    // Columns that never change after construction, shared by copies and secure variants
+    struct Structure {
+        std::vector<int> cost;          // Cost (memory) of every node
+        std::vector<int> latency;       // Latency of every node
+        std::vector<int> parent;        // Parent identifier of every node (-1 for the root)
+        std::vector<int> childOffset;   // CSR offsets: children of id are childIds[childOffset[id] .. childOffset[id + 1])
+        std::vector<int> childIds;      // CSR child identifiers, ascending within each node
+        int root = -1;                  // Identifier of the root node
+    };
+
+    // Function to return the structure of the empty tree (shared by every default-constructed tree)
+    static std::shared_ptr<const Structure> emptyStructure();
+
+    std::shared_ptr<const Structure> structure_ = emptyStructure();
+    std::vector<std::uint8_t> secure_;   // Secure computation flag of every node
+};
+
+// Topology of a generated tree
+enum class TreeShape {
+    Random,   // Node i hangs below a parent drawn uniformly from [0, i)
+    Chain,    // Node i hangs below node i - 1 (depth n)
+    Star,     // Every node hangs below the root (depth 1)
+    Binary,        // Complete binary tree in heap order (depth log n)
+    KAry,          // Complete kTreeArity-ary tree in heap order
+    Caterpillar,   // Spine of every (kCaterpillarLegs + 1)-th node, each with kCaterpillarLegs leaves
+    PowerLaw       // Copying model: node i hangs below a uniform earlier node or, with probability 1/2,
+                   // below that node's parent, so in-degrees follow a power law
+};
+
+// Children per node of a k-ary tree
+constexpr int kTreeArity = 4;
+
+// Leaves hanging off every spine node of a caterpillar tree
+constexpr int kCaterpillarLegs = 3;
+
+// Function to parse "random", "chain", "star", "binary", "kary", "caterpillar" or "powerlaw"
+// (throws std::invalid_argument otherwise)
+TreeShape parseTreeShape(const std::string& name);
+
+// Function to return the command line name of a tree shape
+const char* treeShapeName(TreeShape shape);
+
+// Function to generate a tree of the given shape whose first secureNodeCount nodes require
+// secure computation (for a random shape node i hangs below a parent drawn from [0, i)).
+// Node i takes its weights and parent from block i of the seed's tree-generation stream, so
+// with a pool the columns and the child lists are built in parallel and the tree is the same
+// for any thread count.
+WorkflowTree generateTree(int numNodes, int secureNodeCount, WeightRange cost, WeightRange latency, std::uint64_t seed,
+                          TreeShape shape = TreeShape::Random, WorkStealingPool* pool = nullptr);
+
+// Function to list the nodes of the subtree rooted at start in breadth-first order
+std::vector<int> breadthFirstOrder(const WorkflowTree& tree, int start);
+
+} // namespace sasap
+
+#endif // SASAP_WORKFLOW_TREE_H
@@ -0,0 +1,63 @@
+// Checks the guarantee of the bicriteria FPTAS: every composite function meets the latency
+// limit exactly and the cost limit within a factor (1 + epsilon), no more functions are used
+// than a feasible partitioning for the exact limits needs, and the pooled engine matches the
+// serial one.
+
+#include <cstdint>
+#include <vector>
+
+#include "Check.h"
+#include "sasap/BicriteriaFptas.h"
+#include "sasap/MinimumPartitioning.h"
+#include "sasap/WorkStealingPool.h"
+#include "sasap/WorkflowTree.h"
+
+using namespace sasap;
+
+namespace {
+
+void checkBound(const WorkflowTree& tree, int latencyLimit, int costLimit, double epsilon, WorkStealingPool& pool) {
+    BicriteriaOptions options;
+    options.epsilon = epsilon;
+    options.maxFrontier = 0;   // Unbounded, so the guarantee holds
+    BicriteriaResult result = bicriteriaPartition(tree, latencyLimit, costLimit, options);
+    SASAP_CHECK(result.cappedSteps == 0);
+
+    std::vector<int> seen(tree.size(), 0);
+    for (std::size_t f = 0; f < result.size(); ++f) {
+        std::int64_t cost = 0, latency = 0;
+        for (int i = result.offset[f]; i < result.offset[f + 1]; ++i) {
+            int node = result.nodes[i];
+            ++seen[node];
+            SASAP_CHECK(result.partitionOf[node] == static_cast<int>(f));
+            cost += tree.cost(node);
+            latency += tree.latency(node);
+        }
+        SASAP_CHECK(cost == result.totalCost[f] && latency == result.totalLatency[f]);
+        SASAP_CHECK(latency <= latencyLimit);
+        SASAP_CHECK(cost <= (1.0 + epsilon) * costLimit);
+    }
+    for (int count : seen) {
+        SASAP_CHECK(count == 1);
+    }
+
+    // Any partitioning that meets the exact limits is an upper bound on the optimum
+    LinkageList linkages;
+    PartitionList feasible = minimumTreePartitioning(tree, latencyLimit, costLimit, linkages, false);
+    SASAP_CHECK(result.size() <= feasible.size());
+
+    BicriteriaResult pooled = bicriteriaPartition(tree, latencyLimit, costLimit, options, pool, 16);
+    SASAP_CHECK(pooled.partitionOf == result.partitionOf && pooled.offset == result.offset && pooled.nodes == result.nodes);
+}
+
+} // namespace
+
+int main() {
+    WorkStealingPool pool(4);
+    for (std::uint64_t seed = 1; seed <= 4; ++seed) {
+        WorkflowTree tree = generateTree(3000, 0, { 1, 20 }, { 1, 10 }, seed, seed % 2 ? TreeShape::Random : TreeShape::KAry);
+        checkBound(tree, 50, 100, 0.1, pool);
+        checkBound(tree, 30, 60, 0.5, pool);
+    }
+    return test::finishTests("BicriteriaFptasTest");
+}
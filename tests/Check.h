@@ -0,0 +1,38 @@
+/*
+
+   Minimal checking for the test programs. A failed SASAP_CHECK prints its file, line and
+   expression and the program carries on, so one run reports every broken property;
+   finishTests turns the failure count into the exit status that ctest reads.
+
+*/
+
+#ifndef SASAP_TESTS_CHECK_H
+#define SASAP_TESTS_CHECK_H
+
+#include <iostream>
+
+namespace sasap::test {
+
+// Number of failed checks so far
+inline int& failureCount() {
+    static int failures = 0;
+    return failures;
+}
+
+// Function to report the result of a test program and return its exit status
+inline int finishTests(const char* name) {
+    std::cout << name << ": " << (failureCount() == 0 ? "passed" : "FAILED") << " (" << failureCount() << " failed checks)" << std::endl;
+    return failureCount() == 0 ? 0 : 1;
+}
+
+} // namespace sasap::test
+
+#define SASAP_CHECK(condition)                                                                  \
+    do {                                                                                        \
+        if (!(condition)) {                                                                     \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << '\n';  \
+            ++sasap::test::failureCount();                                                      \
+        }                                                                                       \
+    } while (0)
+
+#endif // SASAP_TESTS_CHECK_H
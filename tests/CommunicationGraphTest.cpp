@@ -0,0 +1,176 @@
+// Checks the partition-level views of a partitioning. The communication graph must hold one
+// edge per ordered pair of partitions with the linkage, secure-linkage and byte counts that a
+// direct count over the linkages gives, in CSR form with ascending targets. The partition DAG
+// must put two partitions in the same group exactly when each reaches the other, and number
+// the groups so that every edge goes forward.
+
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "Check.h"
+#include "sasap/CommunicationGraph.h"
+#include "sasap/PartitionDag.h"
+#include "sasap/Random.h"
+#include "sasap/SasapPartitioning.h"
+#include "sasap/WorkflowTree.h"
+
+using namespace sasap;
+
+namespace {
+
+// Function to compare the graph with a direct count of the linkages per ordered partition pair
+void checkGraph(const WorkflowTree& tree, const std::vector<int>& partitionOf, int partitionCount,
+                const LinkageList& linkages, const TrafficModel& model) {
+    const CommunicationGraph graph = buildCommunicationGraph(tree, partitionOf, partitionCount, linkages, model);
+
+    std::map<std::pair<int, int>, std::tuple<int, int, std::uint64_t>> expected;
+    std::size_t local = 0;
+    for (const Linkage& linkage : linkages) {
+        const int from = partitionOf[linkage.fromNode], to = partitionOf[linkage.toNode];
+        if (from == to) {
+            ++local;
+            continue;
+        }
+        const bool secure = tree.isSecure(linkage.fromNode) || tree.isSecure(linkage.toNode);
+        auto& [count, secureCount, bytes] = expected[{ from, to }];
+        ++count;
+        secureCount += secure ? 1 : 0;
+        bytes += model.payloadBytes + (secure ? model.secureOverheadBytes : 0);
+    }
+
+    SASAP_CHECK(graph.partitionCount() == partitionCount);
+    SASAP_CHECK(graph.localLinkages == local);
+    SASAP_CHECK(static_cast<std::size_t>(graph.edgeCount()) == expected.size());
+    SASAP_CHECK(graph.edgeOffset.front() == 0 && graph.edgeOffset.back() == graph.edgeCount());
+    CommunicationTotals totals;
+    auto next = expected.begin();   // Map order is source, then target: the CSR order
+    for (int p = 0; p < graph.partitionCount(); ++p) {
+        SASAP_CHECK(graph.firstEdge(p) <= graph.lastEdge(p));
+        for (int e = graph.firstEdge(p); e < graph.lastEdge(p) && next != expected.end(); ++e, ++next) {
+            const auto& [count, secureCount, bytes] = next->second;
+            SASAP_CHECK(next->first == std::make_pair(p, graph.target[e]));
+            SASAP_CHECK(graph.linkages[e] == count && graph.secureLinkages[e] == secureCount && graph.bytes[e] == bytes);
+            totals.linkages += count;
+            totals.secureLinkages += secureCount;
+            totals.bytes += bytes;
+            totals.secureBytes += secureCount > 0 ? bytes : 0;
+        }
+    }
+    const CommunicationTotals computed = communicationTotals(graph);
+    SASAP_CHECK(computed.edges == expected.size() && computed.linkages == totals.linkages);
+    SASAP_CHECK(computed.secureLinkages == totals.secureLinkages);
+    SASAP_CHECK(computed.bytes == totals.bytes && computed.secureBytes == totals.secureBytes);
+    SASAP_CHECK(computed.linkages + local == linkages.size());
+}
+
+// Function to check the group DAG against reachability computed by brute force
+void checkDag(int partitionCount, const std::vector<std::pair<int, int>>& edges) {
+    const PartitionDag dag = buildPartitionDag(partitionCount, edges);
+    SASAP_CHECK(static_cast<int>(dag.groupOf.size()) == partitionCount);
+    SASAP_CHECK(dag.memberOffset.front() == 0 && static_cast<std::size_t>(dag.memberOffset.back()) == dag.members.size());
+    SASAP_CHECK(static_cast<int>(dag.members.size()) == partitionCount);
+    for (int g = 0; g < dag.groupCount(); ++g) {
+        SASAP_CHECK(dag.memberOffset[g] < dag.memberOffset[g + 1]);
+        for (int i = dag.memberOffset[g]; i < dag.memberOffset[g + 1]; ++i) {
+            SASAP_CHECK(dag.groupOf[dag.members[i]] == g);
+        }
+    }
+
+    std::vector<std::vector<char>> reaches(partitionCount, std::vector<char>(partitionCount, 0));
+    for (int p = 0; p < partitionCount; ++p) {
+        reaches[p][p] = 1;
+    }
+    for (const auto& [from, to] : edges) {
+        reaches[from][to] = 1;
+    }
+    for (int k = 0; k < partitionCount; ++k) {
+        for (int i = 0; i < partitionCount; ++i) {
+            for (int j = 0; reaches[i][k] && j < partitionCount; ++j) {
+                reaches[i][j] = reaches[i][j] || reaches[k][j];
+            }
+        }
+    }
+    for (int a = 0; a < partitionCount; ++a) {
+        for (int b = 0; b < partitionCount; ++b) {
+            SASAP_CHECK((dag.groupOf[a] == dag.groupOf[b]) == (reaches[a][b] && reaches[b][a]));
+        }
+    }
+    for (const auto& [from, to] : edges) {
+        SASAP_CHECK(dag.groupOf[from] <= dag.groupOf[to]);
+    }
+}
+
+} // namespace
+
+int main() {
+    const TrafficModel model;
+
+    // Linkages of real partitionings, placement and locality modes
+    for (int secureNodes : { 0, 200, 2000 }) {
+        WorkflowTree tree = generateTree(2000, secureNodes, { 1, 20 }, { 1, 10 }, 22);
+        for (bool locality : { false, true }) {
+            LinkageList linkages;
+            PartitionList partitions = locality ? localityTreePartitioning(tree, 50, 100, linkages)
+                                                : improvedTreePartitioning(tree, 50, 100, linkages);
+            std::vector<int> partitionOf(tree.size());
+            std::vector<std::pair<int, int>> edges;
+            for (std::size_t p = 0; p < partitions.size(); ++p) {
+                for (int node : partitions[p].nodes) {
+                    partitionOf[node] = static_cast<int>(p);
+                }
+            }
+            checkGraph(tree, partitionOf, static_cast<int>(partitions.size()), linkages, model);
+            const CommunicationGraph graph = buildCommunicationGraph(tree, partitions, linkages, model);
+            SASAP_CHECK(graph.target == buildCommunicationGraph(tree, partitionOf, graph.partitionCount(), linkages, model).target);
+            for (int p = 0; p < graph.partitionCount(); ++p) {
+                for (int e = graph.firstEdge(p); e < graph.lastEdge(p); ++e) {
+                    edges.emplace_back(p, graph.target[e]);
+                }
+            }
+            checkDag(static_cast<int>(partitions.size()), edges);
+        }
+    }
+
+    // Random assignments to a few partitions, so most pairs communicate and cycles are common
+    RandomStream random(22, RandomStreamId::WorkflowDrift);
+    for (int round = 0; round < 40; ++round) {
+        WorkflowTree tree = generateTree(300, static_cast<int>(random.below(300)), { 1, 20 }, { 1, 10 }, 100 + round);
+        const int partitionCount = 1 + static_cast<int>(random.below(30));
+        std::vector<int> partitionOf(tree.size());
+        for (int& p : partitionOf) {
+            p = static_cast<int>(random.below(partitionCount));
+        }
+        LinkageList linkages;
+        for (int node = 0; node < tree.size(); ++node) {
+            if (tree.parent(node) >= 0) {
+                linkages.push_back({ tree.parent(node), node });
+            }
+        }
+        checkGraph(tree, partitionOf, partitionCount, linkages, { 16, 28 });
+
+        std::vector<std::pair<int, int>> edges;
+        const int edgeCount = static_cast<int>(random.below(3 * partitionCount));
+        for (int e = 0; e < edgeCount; ++e) {
+            edges.emplace_back(static_cast<int>(random.below(partitionCount)), static_cast<int>(random.below(partitionCount)));
+        }
+        checkDag(partitionCount, edges);
+    }
+    checkDag(0, {});
+
+    // A linkage to a node outside the partition map is rejected
+    WorkflowTree tree = generateTree(10, 0, { 1, 20 }, { 1, 10 }, 1);
+    LinkageList outside;
+    outside.push_back({ 0, 10 });
+    bool threw = false;
+    try {
+        buildCommunicationGraph(tree, std::vector<int>(10, 0), 1, outside);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    SASAP_CHECK(threw);
+    return test::finishTests("CommunicationGraphTest");
+}
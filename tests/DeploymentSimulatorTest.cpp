@@ -0,0 +1,158 @@
+// Checks the deployment simulator: a hand-worked chain gives the expected schedule, cold
+// starts, transfers and critical path; a second request finds warm instances; secure edges
+// are encrypted; cyclic partitions run as one group; more vCPUs never slow a request down;
+// the same inputs give the same trace; and on generated workflows the counters add up.
+
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Check.h"
+#include "sasap/CommunicationGraph.h"
+#include "sasap/DeploymentSimulator.h"
+#include "sasap/SasapPartitioning.h"
+#include "sasap/WorkflowTree.h"
+
+using namespace sasap;
+
+namespace {
+
+// Function to build the partitions with the given members
+PartitionList makePartitions(const WorkflowTree& tree, const std::vector<std::vector<int>>& members) {
+    PartitionList partitions;
+    for (const std::vector<int>& nodes : members) {
+        Partition partition{ 0, 0, std::pmr::vector<int>(nodes.begin(), nodes.end()), false };
+        for (int node : nodes) {
+            partition.totalCost += tree.cost(node);
+            partition.totalLatency += tree.latency(node);
+            partition.hasSecureNode = partition.hasSecureNode || tree.isSecure(node);
+        }
+        partitions.push_back(std::move(partition));
+    }
+    return partitions;
+}
+
+// Function to list every parent-child edge as a linkage
+LinkageList treeLinkages(const WorkflowTree& tree) {
+    LinkageList linkages;
+    for (int node = 0; node < tree.size(); ++node) {
+        if (tree.parent(node) >= 0) {
+            linkages.push_back({ tree.parent(node), node });
+        }
+    }
+    return linkages;
+}
+
+bool near(double a, double b) {
+    return a - b < 1e-9 && b - a < 1e-9;
+}
+
+} // namespace
+
+int main() {
+    // Chain 0 -> 1 -> 2 of latencies 1, 2, 3, one node per partition. With 10 ms per latency
+    // unit, 250 ms cold starts and 5 ms + 1 ms per transfer (48 bytes at 48 bytes per ms):
+    // 0..260, transfer to 266, 266..536, transfer to 542, 542..822
+    WorkflowTree chain = WorkflowTree::fromParents({ 1, 1, 1 }, { 1, 2, 3 }, { 0, 0, 0 }, { -1, 0, 1 });
+    PartitionList partitions = makePartitions(chain, { { 0 }, { 1 }, { 2 } });
+    LinkageList linkages = treeLinkages(chain);
+    CommunicationGraph graph = buildCommunicationGraph(chain, partitions, linkages);
+    DeploymentModel model;
+    model.bytesPerMs = 48.0;
+    DeploymentReport report = simulateDeployment(chain, partitions, graph, model);
+    SASAP_CHECK(near(report.makespanMs, 822.0) && near(report.meanResponseMs, 822.0) && near(report.maxResponseMs, 822.0));
+    SASAP_CHECK(near(report.serialMs, 72.0) && near(report.busyMs, 810.0) && near(report.utilization, 810.0 / 822.0));
+    SASAP_CHECK(report.executions == 3 && report.coldStarts == 3 && report.transfers == 2 && report.bytes == 96);
+    SASAP_CHECK(report.encryptedBytes == 0 && report.events == 6);
+    SASAP_CHECK(report.dag.groupCount() == 3 && near(report.criticalMs, 822.0));
+    SASAP_CHECK((report.criticalGroups == std::vector<int>{ report.dag.groupOf[0], report.dag.groupOf[1], report.dag.groupOf[2] }));
+
+    // A second request 1000 ms later finds every instance warm and takes the serial time;
+    // after the keep-alive has passed it starts cold again
+    model.requests = 2;
+    model.arrivalIntervalMs = 1000.0;
+    report = simulateDeployment(chain, partitions, graph, model);
+    SASAP_CHECK(report.coldStarts == 3 && report.executions == 6 && near(report.makespanMs, 1072.0));
+    SASAP_CHECK(near(report.meanResponseMs, (822.0 + 72.0) / 2) && near(report.maxResponseMs, 822.0));
+    model.keepAliveMs = 100.0;
+    report = simulateDeployment(chain, partitions, graph, model);
+    SASAP_CHECK(report.coldStarts == 6 && near(report.makespanMs, 1822.0));
+    model = DeploymentModel();
+    model.bytesPerMs = 48.0;
+
+    // A secure middle node makes both transfers encrypted: 76-byte frames, 2 ns per byte
+    WorkflowTree secureChain = chain.withSecureFlags({ 0, 1, 0 });
+    PartitionList securePartitions = makePartitions(secureChain, { { 0 }, { 1 }, { 2 } });
+    CommunicationGraph secureGraph = buildCommunicationGraph(secureChain, securePartitions, linkages);
+    report = simulateDeployment(secureChain, securePartitions, secureGraph, model);
+    SASAP_CHECK(report.bytes == 152 && report.encryptedBytes == 152);
+    SASAP_CHECK(near(report.makespanMs, 810.0 + 2 * (5.0 + 76.0 / 48.0 + 76.0 * 2.0 / 1e6)));
+
+    // Partitions {0, 2} and {1} feed each other, so they run as one group
+    PartitionList cyclic = makePartitions(chain, { { 0, 2 }, { 1 } });
+    report = simulateDeployment(chain, cyclic, buildCommunicationGraph(chain, cyclic, linkages), model);
+    SASAP_CHECK(report.dag.groupCount() == 1 && report.executions == 2 && report.coldStarts == 2 && report.transfers == 2);
+    SASAP_CHECK(near(report.makespanMs, 60.0 + 500.0 + 6.0));
+
+    // A root with four leaves: four vCPUs run the leaves side by side
+    WorkflowTree star = WorkflowTree::fromParents({ 1, 1, 1, 1, 1 }, { 1, 4, 4, 4, 4 }, { 0, 0, 0, 0, 0 }, { -1, 0, 0, 0, 0 });
+    PartitionList leaves = makePartitions(star, { { 0 }, { 1 }, { 2 }, { 3 }, { 4 } });
+    CommunicationGraph starGraph = buildCommunicationGraph(star, leaves, treeLinkages(star));
+    double previous = 0.0;
+    for (int vcpus : { 1, 2, 4, 8 }) {
+        model.vcpus = vcpus;
+        report = simulateDeployment(star, leaves, starGraph, model);
+        SASAP_CHECK(report.utilization <= 1.0 + 1e-9);
+        SASAP_CHECK(vcpus == 1 || report.makespanMs <= previous);
+        previous = report.makespanMs;
+    }
+    SASAP_CHECK(near(previous, 260.0 + 6.0 + 290.0));
+
+    // Generated workflows: counters add up and the schedule is reproducible
+    WorkflowTree tree = generateTree(3000, 300, { 1, 20 }, { 1, 10 }, 25);
+    LinkageList treeEdges;
+    PartitionList sasapPartitions = improvedTreePartitioning(tree, 50, 100, treeEdges);
+    CommunicationGraph sasapGraph = buildCommunicationGraph(tree, sasapPartitions, treeEdges);
+    const CommunicationTotals totals = communicationTotals(sasapGraph);
+    model = DeploymentModel();
+    model.vcpus = 8;
+    model.requests = 5;
+    model.arrivalIntervalMs = 200.0;
+    std::ostringstream firstTrace, secondTrace;
+    report = simulateDeployment(tree, sasapPartitions, sasapGraph, model, &firstTrace);
+    simulateDeployment(tree, sasapPartitions, sasapGraph, model, &secondTrace);
+    SASAP_CHECK(!firstTrace.str().empty() && firstTrace.str() == secondTrace.str());
+    SASAP_CHECK(report.executions == sasapPartitions.size() * 5 && report.transfers == totals.edges * 5);
+    SASAP_CHECK(report.bytes == totals.bytes * 5 && report.encryptedBytes == totals.secureBytes * 5);
+    double executionMs = 0.0;
+    for (int node = 0; node < tree.size(); ++node) {
+        executionMs += tree.latency(node) * model.msPerLatencyUnit;
+    }
+    SASAP_CHECK(near(report.busyMs, 5 * executionMs + report.coldStarts * model.coldStartMs));
+    SASAP_CHECK(report.makespanMs * model.vcpus >= report.busyMs - 1e-6 && report.maxResponseMs >= report.meanResponseMs);
+    SASAP_CHECK(report.coldStarts >= sasapPartitions.size() && report.coldStarts <= report.executions);
+
+    // Invalid models and mismatched graphs are rejected
+    for (int invalid = 0; invalid < 3; ++invalid) {
+        DeploymentModel bad;
+        bad.vcpus = invalid == 0 ? 0 : 1;
+        bad.bytesPerMs = invalid == 1 ? 0.0 : 1.0;
+        bad.coldStartMs = invalid == 2 ? -1.0 : 0.0;
+        bool threw = false;
+        try {
+            simulateDeployment(chain, partitions, graph, bad);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        SASAP_CHECK(threw);
+    }
+    bool threw = false;
+    try {
+        simulateDeployment(chain, cyclic, graph, DeploymentModel());
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    SASAP_CHECK(threw);
+    return test::finishTests("DeploymentSimulatorTest");
+}
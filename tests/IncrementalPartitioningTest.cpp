@@ -0,0 +1,138 @@
+// Checks that IncrementalPartitioner keeps every partition within the latency and cost limits
+// while the workflow drifts: attribute updates, subtree removals and subtree insertions, and
+// that a partition's secure flag follows its members when the last secure node leaves.
+
+#include <cstdint>
+#include <vector>
+
+#include "Check.h"
+#include "sasap/IncrementalPartitioning.h"
+#include "sasap/Random.h"
+#include "sasap/WorkflowTree.h"
+
+using namespace sasap;
+
+namespace {
+
+const int kLatencyLimit = 50;
+const int kMemoryLimit = 100;
+
+// Function to check the limits, the totals and the node count from the outside
+void checkLimits(const IncrementalPartitioner& incremental) {
+    SASAP_CHECK(incremental.satisfiesConstraints());
+    PartitionList partitions = incremental.partitions();
+    SASAP_CHECK(static_cast<int>(partitions.size()) == incremental.partitionCount());
+    int members = 0;
+    for (const Partition& partition : partitions) {
+        std::int64_t cost = 0, latency = 0;
+        bool hasSecureNode = false;
+        for (int node : partition.nodes) {
+            SASAP_CHECK(incremental.isAlive(node));
+            cost += incremental.cost(node);
+            latency += incremental.latency(node);
+            hasSecureNode = hasSecureNode || incremental.isSecure(node);
+        }
+        SASAP_CHECK(partition.hasSecureNode == hasSecureNode);
+        SASAP_CHECK(cost == partition.totalCost && latency == partition.totalLatency);
+        SASAP_CHECK(partition.nodes.size() == 1 || (cost <= kMemoryLimit && latency <= kLatencyLimit));
+        members += static_cast<int>(partition.nodes.size());
+    }
+    SASAP_CHECK(members == incremental.nodeCount());
+}
+
+// Function to pick a live node
+int liveNode(const IncrementalPartitioner& incremental, RandomStream& random) {
+    int node;
+    do {
+        node = static_cast<int>(random.below(incremental.nodeLimit()));
+    } while (!incremental.isAlive(node));
+    return node;
+}
+
+// Function to insert a single node below parent and return its identifier
+int insertNode(IncrementalPartitioner& incremental, int parent, bool secure) {
+    WorkflowDelta delta;
+    delta.insertions.push_back({ parent, { 1 }, { 1 }, { static_cast<std::uint8_t>(secure ? 1 : 0) }, { -1 } });
+    incremental.apply(delta);
+    return incremental.nodeLimit() - 1;
+}
+
+// Function to detach the last secure node of a partition, by an update and by a removal, and
+// check that a secure node inserted afterwards does not join the partition it left
+void checkSecureFlagFollowsMembers() {
+    // Secure root with two plain children: one secure partition
+    WorkflowTree tree = WorkflowTree::fromParents({ 1, 1, 1 }, { 1, 1, 1 }, { 1, 0, 0 }, { -1, 0, 0 });
+    IncrementalPartitioner incremental(tree, kLatencyLimit, kMemoryLimit);
+    SASAP_CHECK(incremental.partitionCount() == 1 && incremental.partitions()[0].hasSecureNode);
+
+    WorkflowDelta delta;
+    delta.updates.push_back({ 0, 1, 1, false });
+    incremental.apply(delta);
+    SASAP_CHECK(incremental.partitionCount() == 1 && !incremental.partitions()[0].hasSecureNode);
+    checkLimits(incremental);
+
+    int secureNode = insertNode(incremental, 1, true);
+    SASAP_CHECK(incremental.partitionOf(secureNode) != incremental.partitionOf(0));
+    checkLimits(incremental);
+
+    // Removing the only secure node empties its partition, which must reopen as non-secure
+    delta = WorkflowDelta();
+    delta.removals.push_back(secureNode);
+    incremental.apply(delta);
+    checkLimits(incremental);
+    int plainNode = insertNode(incremental, 2, false);
+    SASAP_CHECK(incremental.partitionOf(plainNode) == incremental.partitionOf(0));
+    secureNode = insertNode(incremental, 2, true);
+    SASAP_CHECK(incremental.partitionOf(secureNode) != incremental.partitionOf(0));
+    checkLimits(incremental);
+}
+
+} // namespace
+
+int main() {
+    checkSecureFlagFollowsMembers();
+    for (PlacementPolicy policy : { PlacementPolicy::FirstFit, PlacementPolicy::BestFit, PlacementPolicy::WorstFit }) {
+        WorkflowTree tree = generateTree(20000, 2000, { 1, 20 }, { 1, 10 }, 11);
+        IncrementalPartitioner incremental(tree, kLatencyLimit, kMemoryLimit, policy);
+        checkLimits(incremental);
+
+        RandomStream random(11, RandomStreamId::WorkflowDrift);
+        for (int round = 0; round < 50; ++round) {
+            WorkflowDelta delta;
+            for (int i = 0; i < 40; ++i) {
+                int node = liveNode(incremental, random);
+                // Heavy drift as well as ordinary drift, so some nodes outgrow their partition
+                bool heavy = random.below(4) == 0;
+                delta.updates.push_back({ node, random.uniform(1, heavy ? 80 : 20), random.uniform(1, heavy ? 40 : 10),
+                                          random.below(10) == 0 });
+            }
+            if (round % 5 == 4) {
+                int node = liveNode(incremental, random);
+                if (incremental.parent(node) >= 0) {
+                    delta.removals.push_back(node);
+                }
+            }
+            SubtreeInsertion insertion;
+            insertion.parent = liveNode(incremental, random);
+            for (int i = 0; i < 8; ++i) {
+                insertion.cost.push_back(random.uniform(1, 20));
+                insertion.latency.push_back(random.uniform(1, 10));
+                insertion.secure.push_back(random.below(5) == 0 ? 1 : 0);
+                insertion.localParent.push_back(i == 0 ? -1 : static_cast<int>(random.below(i)));
+            }
+            // The insertion parent must survive the removal applied before it
+            bool parentRemoved = false;
+            for (int removed : delta.removals) {
+                for (int node = insertion.parent; node >= 0; node = incremental.parent(node)) {
+                    parentRemoved = parentRemoved || node == removed;
+                }
+            }
+            if (!parentRemoved) {
+                delta.insertions.push_back(insertion);
+            }
+            incremental.apply(delta);
+            checkLimits(incremental);
+        }
+    }
+    return test::finishTests("IncrementalPartitioningTest");
+}
@@ -0,0 +1,96 @@
+// Checks localityTreePartitioning on every tree shape, placement policy and a range of seed
+// fractions: every node is placed exactly once, no multi-node partition exceeds a limit,
+// secure placement follows SASAP's rule (a partition holding a secure node was opened by
+// one), and the linkages are exactly the edges between different partitions.
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Check.h"
+#include "sasap/SasapPartitioning.h"
+#include "sasap/WorkflowTree.h"
+
+using namespace sasap;
+
+namespace {
+
+const int kLatencyLimit = 50;
+const int kMemoryLimit = 100;
+
+// Function to check one locality partitioning against the tree it was computed for
+void checkLocality(const WorkflowTree& tree, const PartitionList& partitions, const LinkageList& linkages) {
+    std::vector<int> partitionOf(tree.size(), -1);
+    for (std::size_t p = 0; p < partitions.size(); ++p) {
+        const Partition& partition = partitions[p];
+        SASAP_CHECK(!partition.nodes.empty());
+        std::int64_t cost = 0, latency = 0;
+        bool hasSecureNode = false;
+        for (int node : partition.nodes) {
+            SASAP_CHECK(partitionOf[node] == -1);
+            partitionOf[node] = static_cast<int>(p);
+            cost += tree.cost(node);
+            latency += tree.latency(node);
+            hasSecureNode = hasSecureNode || tree.isSecure(node);
+        }
+        SASAP_CHECK(cost == partition.totalCost && latency == partition.totalLatency);
+        SASAP_CHECK(partition.nodes.size() == 1 || (cost <= kMemoryLimit && latency <= kLatencyLimit));
+        SASAP_CHECK(partition.hasSecureNode == hasSecureNode);
+        // Members are listed in the order they joined, so the first one opened the partition
+        SASAP_CHECK(!hasSecureNode || tree.isSecure(partition.nodes.front()));
+    }
+    SASAP_CHECK(std::count(partitionOf.begin(), partitionOf.end(), -1) == 0);
+
+    // Exactly the cut edges, each once
+    std::vector<std::pair<int, int>> emitted, cut;
+    for (const Linkage& linkage : linkages) {
+        emitted.emplace_back(linkage.fromNode, linkage.toNode);
+    }
+    for (int node = 0; node < tree.size(); ++node) {
+        int parent = tree.parent(node);
+        if (parent >= 0 && partitionOf[parent] != partitionOf[node]) {
+            cut.emplace_back(parent, node);
+        }
+    }
+    std::sort(emitted.begin(), emitted.end());
+    std::sort(cut.begin(), cut.end());
+    SASAP_CHECK(emitted == cut);
+}
+
+} // namespace
+
+int main() {
+    for (TreeShape shape : { TreeShape::Random, TreeShape::Chain, TreeShape::Star, TreeShape::Binary, TreeShape::KAry,
+                             TreeShape::Caterpillar, TreeShape::PowerLaw }) {
+        for (int secureNodes : { 0, 300, 3000 }) {
+            // Weights up to the limits, so some nodes fill a partition on their own
+            WorkflowTree tree = generateTree(3000, secureNodes, { 1, kMemoryLimit }, { 1, kLatencyLimit / 2 }, 21, shape);
+            for (PlacementPolicy policy : { PlacementPolicy::FirstFit, PlacementPolicy::BestFit, PlacementPolicy::WorstFit }) {
+                for (double seedFraction : { 0.0, 0.5, 2.0 }) {
+                    LocalityOptions options;
+                    options.policy = policy;
+                    options.seedFraction = seedFraction;
+                    LinkageList linkages;
+                    PartitionList partitions = localityTreePartitioning(tree, kLatencyLimit, kMemoryLimit, linkages, options);
+                    checkLocality(tree, partitions, linkages);
+                }
+            }
+        }
+    }
+
+    // Secure nodes below a plain root, so secure children miss their parent's partition
+    WorkflowTree tree = generateTree(3000, 3000, { 1, 20 }, { 1, 10 }, 22);
+    std::vector<std::uint8_t> secure(tree.size(), 0);
+    for (int node = 0; node < tree.size(); ++node) {
+        secure[node] = node % 3 == 1;
+    }
+    WorkflowTree mixed = tree.withSecureFlags(std::move(secure));
+    LinkageList linkages;
+    checkLocality(mixed, localityTreePartitioning(mixed, kLatencyLimit, kMemoryLimit, linkages), linkages);
+
+    WorkflowTree empty;
+    LinkageList none;
+    SASAP_CHECK(localityTreePartitioning(empty, kLatencyLimit, kMemoryLimit, none).empty() && none.empty());
+    return test::finishTests("LocalityPartitioningTest");
+}
@@ -0,0 +1,112 @@
+// Checks minimumTreePartitioning against brute force on small trees: without the secure rule
+// and under a single limit it finds the fewest connected partitions, its lower bound is the
+// larger of the two exact single-limit minima, and otherwise it never beats the true optimum
+// while every multi-node partition meets the limits and, with the secure rule, every
+// partition holding a secure node is rooted at one (SASAP's placement rule).
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+#include "Check.h"
+#include "sasap/MinimumPartitioning.h"
+#include "sasap/WorkflowTree.h"
+
+using namespace sasap;
+
+namespace {
+
+// Function to find the fewest connected partitions by trying every set of cut edges. A
+// partition over a limit is allowed only when it is a single node, as in the partitioner;
+// with the secure rule a partition rooted at a non-secure node may not hold a secure node.
+int bruteForceMinimum(const WorkflowTree& tree, std::int64_t costLimit, std::int64_t latencyLimit, bool secureRule) {
+    const std::vector<int> order = breadthFirstOrder(tree, tree.root());
+    std::vector<int> edges;   // Child end of every edge
+    for (int node : order) {
+        if (node != tree.root()) {
+            edges.push_back(node);
+        }
+    }
+    int best = INT_MAX;
+    for (unsigned mask = 0; mask < (1u << edges.size()); ++mask) {
+        std::vector<char> cut(tree.size(), 0);
+        cut[tree.root()] = 1;
+        for (std::size_t e = 0; e < edges.size(); ++e) {
+            cut[edges[e]] = (mask >> e) & 1;
+        }
+        std::vector<int> partitionOf(tree.size());
+        std::vector<std::int64_t> cost, latency;
+        std::vector<int> size;
+        std::vector<char> secure;
+        bool feasible = true;
+        for (int node : order) {
+            if (cut[node]) {
+                partitionOf[node] = static_cast<int>(cost.size());
+                cost.push_back(0);
+                latency.push_back(0);
+                size.push_back(0);
+                secure.push_back(tree.isSecure(node));
+            } else {
+                partitionOf[node] = partitionOf[tree.parent(node)];
+                feasible = feasible && !(secureRule && !secure[partitionOf[node]] && tree.isSecure(node));
+            }
+            cost[partitionOf[node]] += tree.cost(node);
+            latency[partitionOf[node]] += tree.latency(node);
+            ++size[partitionOf[node]];
+        }
+        for (std::size_t p = 0; p < cost.size() && feasible; ++p) {
+            feasible = size[p] == 1 || (cost[p] <= costLimit && latency[p] <= latencyLimit);
+        }
+        if (feasible) {
+            best = std::min(best, static_cast<int>(cost.size()));
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+int main() {
+    for (std::uint64_t seed = 1; seed < 1500; ++seed) {
+        const int nodes = 2 + static_cast<int>(seed % 11);
+        const int secureNodes = (seed / 11) % 3 == 0 ? 0 : std::min(nodes, static_cast<int>(seed % 4));
+        WorkflowTree tree = generateTree(nodes, secureNodes, { 1, 40 }, { 1, 30 }, seed);
+        const int latencyLimit = 20 + static_cast<int>(seed % 40);
+        const int memoryLimit = 30 + static_cast<int>(seed * 7 % 60);
+        const bool secureRule = seed % 2 == 1;
+
+        const int memoryOnly = bruteForceMinimum(tree, memoryLimit, LLONG_MAX, false);
+        const int latencyOnly = bruteForceMinimum(tree, LLONG_MAX, latencyLimit, false);
+        const int both = bruteForceMinimum(tree, memoryLimit, latencyLimit, secureRule);
+
+        // Exact under one limit, in either dimension, and the lower bound holds under any secure rule
+        LinkageList memoryLinkages, latencyLinkages;
+        SASAP_CHECK(static_cast<int>(minimumTreePartitioning(tree, INT_MAX, memoryLimit, memoryLinkages, false).size()) == memoryOnly);
+        SASAP_CHECK(static_cast<int>(minimumTreePartitioning(tree, latencyLimit, INT_MAX, latencyLinkages, false).size()) == latencyOnly);
+        SASAP_CHECK(minimumPartitionLowerBound(tree, latencyLimit, memoryLimit)
+                    == static_cast<std::size_t>(std::max(memoryOnly, latencyOnly)));
+        SASAP_CHECK(static_cast<int>(minimumPartitionLowerBound(tree, latencyLimit, memoryLimit)) <= both);
+
+        // Under both limits: feasible, connected pieces, never fewer than the optimum
+        LinkageList linkages;
+        PartitionList partitions = minimumTreePartitioning(tree, latencyLimit, memoryLimit, linkages, secureRule);
+        SASAP_CHECK(static_cast<int>(partitions.size()) >= both);
+        SASAP_CHECK(linkages.size() == partitions.size() - 1);
+        std::size_t placed = 0;
+        for (const Partition& partition : partitions) {
+            SASAP_CHECK(partition.nodes.size() == 1 || (partition.totalCost <= memoryLimit && partition.totalLatency <= latencyLimit));
+            SASAP_CHECK(!secureRule || !partition.hasSecureNode || tree.isSecure(partition.nodes.front()));
+            bool hasSecureNode = false;
+            for (int node : partition.nodes) {
+                hasSecureNode = hasSecureNode || tree.isSecure(node);
+                SASAP_CHECK(node == partition.nodes.front() || std::find(partition.nodes.begin(), partition.nodes.end(),
+                                                                         tree.parent(node)) != partition.nodes.end());
+            }
+            SASAP_CHECK(partition.hasSecureNode == hasSecureNode);
+            placed += partition.nodes.size();
+        }
+        SASAP_CHECK(placed == static_cast<std::size_t>(tree.size()));
+    }
+    return test::finishTests("MinimumPartitioningTest");
+}
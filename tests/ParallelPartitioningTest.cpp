@@ -0,0 +1,114 @@
+// Checks that parallelTreePartitioning gives the same partitions and linkages whatever the
+// number of threads, that every partition it returns is a valid SASAP partition, and that
+// splitting the tree costs only a few partitions over the serial run, also on shapes with
+// very many small subtrees below the spine (stars and caterpillars).
+
+#include <cstdint>
+#include <vector>
+
+#include "Check.h"
+#include "sasap/SasapPartitioning.h"
+#include "sasap/SubtreeSplit.h"
+#include "sasap/WorkStealingPool.h"
+#include "sasap/WorkflowTree.h"
+
+using namespace sasap;
+
+namespace {
+
+const int kLatencyLimit = 50;
+const int kMemoryLimit = 100;
+
+// Function to compare two partitionings member by member
+bool samePartitions(const PartitionList& a, const PartitionList& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t p = 0; p < a.size(); ++p) {
+        if (a[p].totalCost != b[p].totalCost || a[p].totalLatency != b[p].totalLatency
+            || a[p].hasSecureNode != b[p].hasSecureNode || a[p].nodes != b[p].nodes) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool sameLinkages(const LinkageList& a, const LinkageList& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].fromNode != b[i].fromNode || a[i].toNode != b[i].toNode) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Function to check that every node is placed once, totals add up and the limits and secure rule hold
+void checkValid(const WorkflowTree& tree, const PartitionList& partitions, const LinkageList& linkages) {
+    std::vector<int> seen(tree.size(), 0);
+    for (const Partition& partition : partitions) {
+        std::int64_t cost = 0, latency = 0;
+        for (int node : partition.nodes) {
+            ++seen[node];
+            cost += tree.cost(node);
+            latency += tree.latency(node);
+            SASAP_CHECK(!tree.isSecure(node) || partition.hasSecureNode);
+        }
+        SASAP_CHECK(cost == partition.totalCost && latency == partition.totalLatency);
+        SASAP_CHECK(partition.nodes.size() == 1 || (cost <= kMemoryLimit && latency <= kLatencyLimit));
+    }
+    for (int count : seen) {
+        SASAP_CHECK(count == 1);
+    }
+    SASAP_CHECK(linkages.size() == static_cast<std::size_t>(tree.size() - 1));
+}
+
+void checkShape(TreeShape shape, int nodes) {
+    WorkflowTree tree = generateTree(nodes, nodes / 10, { 1, 20 }, { 1, 10 }, 7, shape);
+    LinkageList serialLinkages;
+    PartitionList serial = improvedTreePartitioning(tree, kLatencyLimit, kMemoryLimit, serialLinkages);
+
+    // Small subtrees are grouped, so the task count stays near the target whatever the shape
+    const std::size_t targetTasks = 256;
+    SubtreeSplit split = splitIntoSubtrees(tree, targetTasks);
+    SASAP_CHECK(split.taskCount() <= targetTasks + 1);
+    std::vector<int> covered = split.spine;
+    for (std::size_t task = 0; task < split.taskCount(); ++task) {
+        std::vector<int> order = taskOrder(tree, split, task);
+        covered.insert(covered.end(), order.begin(), order.end());
+    }
+    SASAP_CHECK(covered.size() == static_cast<std::size_t>(tree.size()));
+
+    LinkageList reference;
+    PartitionList expected;
+    for (unsigned threads : { 1u, 2u, 4u }) {
+        WorkStealingPool pool(threads);
+        LinkageList linkages;
+        PartitionList partitions = parallelTreePartitioning(tree, kLatencyLimit, kMemoryLimit, linkages,
+                                                            PlacementPolicy::FirstFit, pool, targetTasks);
+        checkValid(tree, partitions, linkages);
+        if (threads == 1) {
+            expected = partitions;
+            reference = linkages;
+        } else {
+            SASAP_CHECK(samePartitions(partitions, expected));
+            SASAP_CHECK(sameLinkages(linkages, reference));
+        }
+    }
+    // Every task boundary can leave a partially filled partition behind; beyond that the packing
+    // is within one percent of the serial run (one partition per node would be far outside)
+    SASAP_CHECK(expected.size() <= serial.size() + serial.size() / 100 + split.taskCount() + 1);
+}
+
+} // namespace
+
+int main() {
+    checkShape(TreeShape::Random, 50000);
+    checkShape(TreeShape::Binary, 50000);
+    checkShape(TreeShape::PowerLaw, 50000);
+    checkShape(TreeShape::Star, 300000);
+    checkShape(TreeShape::Caterpillar, 300000);
+    return test::finishTests("ParallelPartitioningTest");
+}
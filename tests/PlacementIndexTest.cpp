@@ -0,0 +1,123 @@
+// Checks that PlacementIndex picks the same partition as a linear scan over the partitions in
+// creation order, for every policy, with and without the per-threshold rows (small and large
+// latency limits), and that improvedTreePartitioning with first-fit reproduces the original
+// scanning placement of SASAP node for node.
+
+#include <cstdint>
+#include <vector>
+
+#include "Check.h"
+#include "sasap/PlacementIndex.h"
+#include "sasap/Random.h"
+#include "sasap/SasapPartitioning.h"
+#include "sasap/WorkflowTree.h"
+
+using namespace sasap;
+
+namespace {
+
+struct Bin {
+    int latency;   // Used latency
+    int memory;    // Used memory
+    bool secure;
+};
+
+// Function to choose a partition by scanning them all, as SASAP did before the index
+int linearScan(const std::vector<Bin>& bins, int latencyLimit, int memoryLimit, PlacementPolicy policy,
+               int latency, int memory, bool secure) {
+    int chosen = -1;
+    for (int p = 0; p < static_cast<int>(bins.size()); ++p) {
+        const Bin& bin = bins[p];
+        if (bin.latency + latency > latencyLimit || bin.memory + memory > memoryLimit || (secure && !bin.secure)) {
+            continue;
+        }
+        if (policy == PlacementPolicy::FirstFit) {
+            return p;
+        }
+        // Strict comparisons keep ties on the older partition
+        int remaining = memoryLimit - bin.memory;
+        int chosenRemaining = chosen == -1 ? 0 : memoryLimit - bins[chosen].memory;
+        if (chosen == -1 || (policy == PlacementPolicy::BestFit ? remaining < chosenRemaining : remaining > chosenRemaining)) {
+            chosen = p;
+        }
+    }
+    return chosen;
+}
+
+// Function to replay random placements, with some partitions shrinking again, against the scan
+void checkIndex(int latencyLimit, int memoryLimit, PlacementPolicy policy, std::uint64_t seed) {
+    RandomStream random(seed, RandomStreamId::WorkflowDrift);
+    PlacementIndex index(latencyLimit, memoryLimit, policy);
+    std::vector<Bin> bins;
+    int mismatches = 0;
+    for (int step = 0; step < 20000; ++step) {
+        if (!bins.empty() && random.below(10) == 0) {
+            int p = static_cast<int>(random.below(bins.size()));
+            bins[p].latency = static_cast<int>(random.below(bins[p].latency + 1));
+            bins[p].memory = static_cast<int>(random.below(bins[p].memory + 1));
+            index.updatePartition(p, bins[p].latency, bins[p].memory);
+            continue;
+        }
+        int latency = random.uniform(1, latencyLimit / 4);
+        int memory = random.uniform(1, memoryLimit / 4);
+        bool secure = random.below(5) == 0;
+        int expected = linearScan(bins, latencyLimit, memoryLimit, policy, latency, memory, secure);
+        int found = index.findPartition(latency, memory, secure);
+        mismatches += found != expected;
+        if (expected == -1) {
+            index.addPartition(static_cast<int>(bins.size()), latency, memory, secure);
+            bins.push_back({ latency, memory, secure });
+        } else {
+            bins[expected].latency += latency;
+            bins[expected].memory += memory;
+            index.updatePartition(expected, bins[expected].latency, bins[expected].memory);
+        }
+    }
+    SASAP_CHECK(mismatches == 0);
+}
+
+// Function to partition a tree with the original scanning first-fit loop
+std::vector<std::vector<int>> scanningPartitioning(const WorkflowTree& tree, int latencyLimit, int memoryLimit) {
+    std::vector<Bin> bins;
+    std::vector<std::vector<int>> members;
+    for (int node : breadthFirstOrder(tree, tree.root())) {
+        int p = linearScan(bins, latencyLimit, memoryLimit, PlacementPolicy::FirstFit, tree.latency(node), tree.cost(node),
+                           tree.isSecure(node));
+        if (p == -1) {
+            bins.push_back({ tree.latency(node), tree.cost(node), tree.isSecure(node) });
+            members.push_back({ node });
+        } else {
+            bins[p].latency += tree.latency(node);
+            bins[p].memory += tree.cost(node);
+            members[p].push_back(node);
+        }
+    }
+    return members;
+}
+
+void checkTree(TreeShape shape, int latencyLimit, int memoryLimit) {
+    WorkflowTree tree = generateTree(20000, 4000, { 1, 20 }, { 1, 10 }, 3, shape);
+    LinkageList linkages;
+    PartitionList partitions = improvedTreePartitioning(tree, latencyLimit, memoryLimit, linkages);
+    std::vector<std::vector<int>> expected = scanningPartitioning(tree, latencyLimit, memoryLimit);
+    SASAP_CHECK(partitions.size() == expected.size());
+    bool same = partitions.size() == expected.size();
+    for (std::size_t p = 0; same && p < partitions.size(); ++p) {
+        same = std::vector<int>(partitions[p].nodes.begin(), partitions[p].nodes.end()) == expected[p];
+    }
+    SASAP_CHECK(same);
+}
+
+} // namespace
+
+int main() {
+    for (PlacementPolicy policy : { PlacementPolicy::FirstFit, PlacementPolicy::BestFit, PlacementPolicy::WorstFit }) {
+        checkIndex(50, 100, policy, 1);       // Latency capacity small enough for threshold rows
+        checkIndex(1000, 400, policy, 2);     // Pruning on the per-dimension maxima only
+        checkIndex(8, 1000000, policy, 3);    // Latency-bound bins
+    }
+    checkTree(TreeShape::Random, 50, 100);
+    checkTree(TreeShape::Star, 50, 100);
+    checkTree(TreeShape::Random, 1000, 2000);
+    return test::finishTests("PlacementIndexTest");
+}
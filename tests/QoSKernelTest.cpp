@@ -0,0 +1,52 @@
+// Checks that evaluateQoS, which uses the AVX2 kernel where the CPU has it, returns exactly
+// what the scalar kernel returns on random totals, for both scoring models with and without
+// noise, at every length from 0 to 67 (so every tail of 0 to 3 functions) and unaligned input.
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "Check.h"
+#include "sasap/QoS.h"
+#include "sasap/Random.h"
+
+using namespace sasap;
+
+int main() {
+    std::cout << "QoS kernel: " << qosKernelName() << std::endl;
+    RandomStream random(16, RandomStreamId::LatencyJitter);
+    const int costLimit = 100, latencyLimit = 50;
+    QoSNoise noise;
+    noise.seed = 7;
+    const QoSNoise* noises[] = { nullptr, &noise };
+
+    for (std::size_t count = 0; count < 68; ++count) {
+        // One extra leading element, so the kernels also read from an unaligned address
+        std::vector<std::int64_t> cost(count + 1), latency(count + 1);
+        for (std::size_t i = 0; i <= count; ++i) {
+            // Mostly near the limits, sometimes far above them (the kernel converts exactly below 2^51)
+            bool huge = random.below(8) == 0;
+            cost[i] = huge ? (static_cast<std::int64_t>(random.next()) << 18) : random.uniform(0, 3 * costLimit);
+            latency[i] = huge ? (static_cast<std::int64_t>(random.next()) << 18) : random.uniform(0, 3 * latencyLimit);
+        }
+        for (QoSModel model : { QoSModel::Satisfaction, QoSModel::Headroom }) {
+            for (const QoSNoise* withNoise : noises) {
+                std::vector<double> dispatched(count), scalar(count);
+                double mean = evaluateQoS(cost.data() + 1, latency.data() + 1, count, costLimit, latencyLimit, model,
+                                          withNoise, dispatched.data());
+                double reference = evaluateQoSScalar(cost.data() + 1, latency.data() + 1, count, costLimit, latencyLimit,
+                                                     model, withNoise, scalar.data());
+                SASAP_CHECK(mean == reference);
+                SASAP_CHECK(dispatched == scalar);
+                SASAP_CHECK(evaluateQoS(cost.data() + 1, latency.data() + 1, count, costLimit, latencyLimit, model, withNoise) == mean);
+            }
+        }
+        // Without noise the satisfaction model scores every function as qosSatisfaction does
+        std::vector<double> scores(count);
+        evaluateQoS(cost.data() + 1, latency.data() + 1, count, costLimit, latencyLimit, QoSModel::Satisfaction, nullptr, scores.data());
+        for (std::size_t i = 0; i < count; ++i) {
+            SASAP_CHECK(scores[i] == qosSatisfaction(cost[i + 1], latency[i + 1], costLimit, latencyLimit));
+        }
+    }
+    return test::finishTests("QoSKernelTest");
+}
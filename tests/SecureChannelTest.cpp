@@ -0,0 +1,100 @@
+// Checks that SecureChannel opens what it sealed back to the original bytes and rejects
+// messages whose payload, tag or nonce was tampered with.
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "Check.h"
+#include "sasap/SecureChannel.h"
+
+using namespace sasap;
+
+namespace {
+
+// Function to fill a batch with messages of varied lengths, the empty message included
+std::vector<std::string> addMessages(MessageBatch& batch) {
+    std::vector<std::string> messages;
+    for (int i = 0; i < 32; ++i) {
+        std::string message(i * 7, '\0');
+        for (std::size_t j = 0; j < message.size(); ++j) {
+            message[j] = static_cast<char>('a' + (i + j) % 26);
+        }
+        batch.add(message.data(), message.size());
+        messages.push_back(message);
+    }
+    return messages;
+}
+
+bool payloadEquals(const MessageBatch& batch, std::size_t i, const std::string& message) {
+    return batch.length(i) == message.size() && std::string(reinterpret_cast<const char*>(batch.payload(i)), batch.length(i)) == message;
+}
+
+} // namespace
+
+int main() {
+    std::array<unsigned char, SecureChannel::kKeySize> key{};
+    for (std::size_t i = 0; i < key.size(); ++i) {
+        key[i] = static_cast<unsigned char>(i * 13 + 1);
+    }
+
+    // Round trip through the batch interface, opened by a second channel holding the same key
+    {
+        SecureChannel sender(key), receiver(key);
+        MessageBatch batch;
+        std::vector<std::string> messages = addMessages(batch);
+        sender.sealBatch(batch);
+        bool changed = false;
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            changed = changed || (batch.length(i) > 0 && !payloadEquals(batch, i, messages[i]));
+        }
+        SASAP_CHECK(changed);
+        SASAP_CHECK(receiver.openBatch(batch));
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            SASAP_CHECK(payloadEquals(batch, i, messages[i]));
+        }
+        SASAP_CHECK(receiver.stats().messages == batch.size());
+    }
+
+    // Round trip through the single-message interface with a fresh random key
+    {
+        SecureChannel channel;
+        std::string message = "secure linkage payload";
+        std::vector<unsigned char> data(message.begin(), message.end());
+        unsigned char nonce[MessageBatch::kNonceSize];
+        unsigned char tag[MessageBatch::kTagSize];
+        channel.seal(data.data(), data.size(), nonce, tag);
+        SASAP_CHECK(channel.open(data.data(), data.size(), nonce, tag));
+        SASAP_CHECK(std::string(data.begin(), data.end()) == message);
+    }
+
+    // Tampering with the payload, the tag or the nonce of one message fails only that message
+    for (int part = 0; part < 3; ++part) {
+        SecureChannel channel(key);
+        MessageBatch batch;
+        std::vector<std::string> messages = addMessages(batch);
+        channel.sealBatch(batch);
+        const std::size_t victim = 5;
+        unsigned char* target = part == 0 ? batch.payload(victim) : part == 1 ? batch.tag(victim) : batch.nonce(victim);
+        target[0] ^= 0x01;
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            bool opened = channel.openMessage(batch, i);
+            SASAP_CHECK(opened == (i != victim));
+            if (opened) {
+                SASAP_CHECK(payloadEquals(batch, i, messages[i]));
+            }
+        }
+    }
+
+    // A channel with another key rejects the whole batch
+    {
+        std::array<unsigned char, SecureChannel::kKeySize> otherKey = key;
+        otherKey[0] ^= 0x80;
+        SecureChannel sender(key), stranger(otherKey);
+        MessageBatch batch;
+        addMessages(batch);
+        sender.sealBatch(batch);
+        SASAP_CHECK(!stranger.openBatch(batch));
+    }
+    return test::finishTests("SecureChannelTest");
+}
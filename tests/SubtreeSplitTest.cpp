@@ -0,0 +1,126 @@
+// Checks the subtree split behind the parallel partitioner: the spine is a connected top of
+// the tree, every other node belongs to exactly one task in breadth-first order, tasks are
+// grouped up to the grain and no task subtree is left above it while splits remain. Also
+// checks Kundu and Misra's bottom-up cutting on hand-worked trees, and that it gives the same
+// partitions from an arena, reset between runs, as from the default resource.
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Check.h"
+#include "sasap/Arena.h"
+#include "sasap/MinimumPartitioning.h"
+#include "sasap/SubtreeSplit.h"
+#include "sasap/WorkflowTree.h"
+
+using namespace sasap;
+
+namespace {
+
+// Function to check one split of the tree for the given arguments
+void checkSplit(const WorkflowTree& tree, std::size_t targetTasks, std::size_t minSubtreeSize) {
+    const std::vector<int> sizes = subtreeSizes(tree);
+    SASAP_CHECK(sizes[tree.root()] == tree.size());
+    for (int node = 0; node < tree.size(); ++node) {
+        int expected = 1;
+        for (int child : tree.children(node)) {
+            expected += sizes[child];
+        }
+        SASAP_CHECK(sizes[node] == expected);
+    }
+
+    const SubtreeSplit split = splitIntoSubtrees(tree, targetTasks, minSubtreeSize);
+    const std::size_t grain = std::max<std::size_t>({ 1, minSubtreeSize, tree.size() / targetTasks });
+    std::vector<int> owner(tree.size(), -2);   // -1 for the spine, the task otherwise
+
+    SASAP_CHECK(!split.spine.empty() && split.spine.front() == tree.root());
+    for (int node : split.spine) {
+        SASAP_CHECK(owner[node] == -2);
+        SASAP_CHECK(node == tree.root() || owner[tree.parent(node)] == -1);   // Parents come first
+        owner[node] = -1;
+    }
+
+    SASAP_CHECK(split.taskOffset.front() == 0 && static_cast<std::size_t>(split.taskOffset.back()) == split.taskRoots.size());
+    for (std::size_t task = 0; task < split.taskCount(); ++task) {
+        SASAP_CHECK(split.taskOffset[task] < split.taskOffset[task + 1]);
+        std::size_t taskSize = 0;
+        for (int i = split.taskOffset[task]; i < split.taskOffset[task + 1]; ++i) {
+            const int root = split.taskRoots[i];
+            SASAP_CHECK(owner[tree.parent(root)] == -1);
+            // While the split budget lasts, every subtree left below the spine is at most the grain
+            SASAP_CHECK(split.spine.size() - 1 >= 4 * targetTasks || static_cast<std::size_t>(sizes[root]) <= grain);
+            taskSize += sizes[root];
+        }
+        SASAP_CHECK(taskSize >= grain || task + 1 == split.taskCount());
+
+        const std::vector<int> order = taskOrder(tree, split, task);
+        SASAP_CHECK(order.size() == taskSize);
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            const int node = order[i];
+            const bool isRoot = static_cast<int>(i) < split.taskOffset[task + 1] - split.taskOffset[task];
+            SASAP_CHECK(owner[node] == -2);
+            SASAP_CHECK(isRoot || owner[tree.parent(node)] == static_cast<int>(task));
+            owner[node] = static_cast<int>(task);
+        }
+    }
+    SASAP_CHECK(std::count(owner.begin(), owner.end(), -2) == 0);
+}
+
+// Function to count the partitions Kundu and Misra's cutting makes under one memory limit
+std::size_t minimumUnderMemory(const WorkflowTree& tree, int memoryLimit) {
+    LinkageList linkages;
+    return minimumTreePartitioning(tree, INT_MAX, memoryLimit, linkages, false).size();
+}
+
+} // namespace
+
+int main() {
+    for (TreeShape shape : { TreeShape::Random, TreeShape::Chain, TreeShape::Star, TreeShape::Binary, TreeShape::KAry,
+                             TreeShape::Caterpillar, TreeShape::PowerLaw }) {
+        WorkflowTree tree = generateTree(40000, 0, { 1, 20 }, { 1, 10 }, 14, shape);
+        for (std::size_t targetTasks : { 1, 8, 256 }) {
+            for (std::size_t minSubtreeSize : { 1, 64, 4096 }) {
+                checkSplit(tree, targetTasks, minSubtreeSize);
+            }
+        }
+    }
+    WorkflowTree single = WorkflowTree::fromParents({ 5 }, { 5 }, { 0 }, { -1 });
+    SubtreeSplit split = splitIntoSubtrees(single, 8, 1);
+    SASAP_CHECK(split.spine.size() == 1 && split.taskCount() == 0);
+
+    // Ten nodes of cost 10 in a chain fit three to a partition of 30: four partitions
+    WorkflowTree chain = WorkflowTree::fromParents(std::vector<int>(10, 10), std::vector<int>(10, 1), std::vector<std::uint8_t>(10, 0),
+                                                   { -1, 0, 1, 2, 3, 4, 5, 6, 7, 8 });
+    SASAP_CHECK(minimumUnderMemory(chain, 30) == 4);
+    // A root of cost 1 with nine leaves of cost 10 keeps three leaves under a limit of 35; the
+    // other six leaves stand alone
+    WorkflowTree star = WorkflowTree::fromParents({ 1, 10, 10, 10, 10, 10, 10, 10, 10, 10 }, std::vector<int>(10, 1),
+                                                  std::vector<std::uint8_t>(10, 0), { -1, 0, 0, 0, 0, 0, 0, 0, 0, 0 });
+    SASAP_CHECK(minimumUnderMemory(star, 35) == 7);
+    // The heaviest child goes first: cutting the child of cost 20 leaves the rest together
+    WorkflowTree uneven = WorkflowTree::fromParents({ 1, 20, 5, 5 }, std::vector<int>(4, 1), std::vector<std::uint8_t>(4, 0),
+                                                    { -1, 0, 0, 0 });
+    SASAP_CHECK(minimumUnderMemory(uneven, 25) == 2);
+
+    // Arena runs, with a reset between them, match the default resource
+    WorkflowTree tree = generateTree(20000, 2000, { 1, 20 }, { 1, 10 }, 15);
+    LinkageList expectedLinkages;
+    PartitionList expected = minimumTreePartitioning(tree, 50, 100, expectedLinkages);
+    Arena arena(64 * 1024);
+    for (int run = 0; run < 3; ++run) {
+        {
+            LinkageList linkages(&arena);
+            PartitionList partitions = minimumTreePartitioning(tree, 50, 100, linkages, true, &arena);
+            SASAP_CHECK(partitions.size() == expected.size() && linkages.size() == expectedLinkages.size());
+            for (std::size_t p = 0; p < partitions.size() && p < expected.size(); ++p) {
+                SASAP_CHECK(std::equal(partitions[p].nodes.begin(), partitions[p].nodes.end(), expected[p].nodes.begin(),
+                                       expected[p].nodes.end()));
+            }
+        }
+        arena.reset();
+    }
+    return test::finishTests("SubtreeSplitTest");
+}
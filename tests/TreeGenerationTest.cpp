@@ -0,0 +1,74 @@
+// Checks the counter-based generator: Philox4x32-10 matches its published known answers, a
+// stream can seek to any position, and generated trees are bit-identical for every shape
+// whether they are built serially or on 1, 2 or 4 threads. A secure variant shares the
+// tree's other columns and matches a tree generated with the same secure count.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "Check.h"
+#include "sasap/Random.h"
+#include "sasap/WorkStealingPool.h"
+#include "sasap/WorkflowTree.h"
+
+using namespace sasap;
+
+namespace {
+
+bool sameTree(const WorkflowTree& a, const WorkflowTree& b) {
+    if (a.size() != b.size() || a.root() != b.root() || a.costs() != b.costs() || a.latencies() != b.latencies()
+        || a.secureFlags() != b.secureFlags() || a.parents() != b.parents()) {
+        return false;
+    }
+    for (int node = 0; node < a.size(); ++node) {
+        ChildRange x = a.children(node), y = b.children(node);
+        if (!std::equal(x.begin(), x.end(), y.begin(), y.end())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    // Known-answer vectors of the Random123 reference implementation
+    SASAP_CHECK((philox4x32({ 0u, 0u, 0u, 0u }, 0) == std::array<std::uint32_t, 4>{ 0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u }));
+    SASAP_CHECK((philox4x32({ 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu }, 0xffffffffffffffffull)
+                 == std::array<std::uint32_t, 4>{ 0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu }));
+
+    // Seeking lands on the same word as drawing up to it
+    RandomStream sequential(99, RandomStreamId::LatencyJitter);
+    std::vector<std::uint32_t> words;
+    for (int i = 0; i < 64; ++i) {
+        words.push_back(sequential.next());
+    }
+    for (std::uint64_t position : { 0u, 1u, 3u, 4u, 5u, 37u, 63u }) {
+        RandomStream seeked(99, RandomStreamId::LatencyJitter, position);
+        SASAP_CHECK(seeked.next() == words[position]);
+    }
+    SASAP_CHECK(RandomStream(99, RandomStreamId::TreeGeneration).next() != words[0]);
+
+    // Same seed, same tree, whatever the number of threads
+    for (TreeShape shape : { TreeShape::Random, TreeShape::Chain, TreeShape::Star, TreeShape::Binary, TreeShape::KAry,
+                             TreeShape::Caterpillar, TreeShape::PowerLaw }) {
+        WorkflowTree serial = generateTree(200000, 20000, { 1, 20 }, { 1, 10 }, 42, shape);
+        for (unsigned threads : { 1u, 2u, 4u }) {
+            WorkStealingPool pool(threads);
+            SASAP_CHECK(sameTree(serial, generateTree(200000, 20000, { 1, 20 }, { 1, 10 }, 42, shape, &pool)));
+        }
+        SASAP_CHECK(!sameTree(serial, generateTree(200000, 20000, { 1, 20 }, { 1, 10 }, 43, shape)));
+    }
+
+    // A secure variant shares the structure and equals the tree generated with its secure count
+    WorkflowTree tree = generateTree(1000, 100, { 1, 20 }, { 1, 10 }, 7);
+    std::vector<std::uint8_t> secure(tree.size(), 0);
+    std::fill(secure.begin(), secure.begin() + 300, std::uint8_t{1});
+    WorkflowTree variant = tree.withSecureFlags(secure);
+    SASAP_CHECK(sameTree(variant, generateTree(1000, 300, { 1, 20 }, { 1, 10 }, 7)));
+    SASAP_CHECK(variant.costs().data() == tree.costs().data() && variant.childIds().data() == tree.childIds().data());
+    SASAP_CHECK(tree.secureFlags() != variant.secureFlags());
+    return test::finishTests("TreeGenerationTest");
+}
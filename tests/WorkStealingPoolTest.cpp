@@ -0,0 +1,67 @@
+// Checks that parallelFor waits only for its own calls: nested inside pool tasks, issued from
+// several threads at once, and with errors reported to the caller whose body threw.
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Check.h"
+#include "sasap/WorkStealingPool.h"
+
+using namespace sasap;
+
+int main() {
+    for (unsigned threads : { 1u, 2u, 4u }) {
+        WorkStealingPool pool(threads);
+
+        // Nested: every outer task runs its own parallelFor on the same pool
+        std::vector<std::atomic<int>> sums(64);
+        pool.parallelFor(sums.size(), [&](std::size_t outer) {
+            pool.parallelFor(100, [&](std::size_t inner) { sums[outer] += static_cast<int>(inner); });
+            // The inner call has returned, so all of its iterations are done
+            SASAP_CHECK(sums[outer].load() == 4950);
+        });
+
+        // Concurrent: callers outside the pool share it without waiting for each other's work
+        std::vector<std::thread> callers;
+        std::vector<std::atomic<int>> counts(4);
+        for (std::size_t caller = 0; caller < counts.size(); ++caller) {
+            callers.emplace_back([&, caller] {
+                for (int round = 0; round < 20; ++round) {
+                    int before = counts[caller].load();
+                    pool.parallelFor(50, [&](std::size_t) { ++counts[caller]; });
+                    SASAP_CHECK(counts[caller].load() == before + 50);
+                }
+            });
+        }
+        for (std::thread& caller : callers) {
+            caller.join();
+        }
+
+        // Errors: the exception reaches the call whose body threw, and the pool stays usable
+        bool caught = false;
+        try {
+            pool.parallelFor(10, [](std::size_t i) {
+                if (i == 3) {
+                    throw std::runtime_error("task 3");
+                }
+            });
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+        SASAP_CHECK(caught);
+        std::atomic<int> after{0};
+        pool.parallelFor(10, [&](std::size_t) { ++after; });
+        SASAP_CHECK(after.load() == 10);
+
+        // Plain submit and wait still drain the whole pool
+        std::atomic<int> submitted{0};
+        for (int i = 0; i < 100; ++i) {
+            pool.submit([&] { ++submitted; });
+        }
+        pool.wait();
+        SASAP_CHECK(submitted.load() == 100);
+    }
+    return test::finishTests("WorkStealingPoolTest");
+}
@@ -0,0 +1,80 @@
+// Checks that a tree written in the text or the binary format reads back unchanged, and that
+// the text loader rejects an identifier the file cannot hold, naming the file and the line.
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "Check.h"
+#include "sasap/WorkflowIO.h"
+#include "sasap/WorkflowTree.h"
+
+using namespace sasap;
+
+namespace {
+
+bool sameTree(const WorkflowTree& a, const WorkflowTree& b) {
+    if (a.size() != b.size() || a.root() != b.root() || a.costs() != b.costs() || a.latencies() != b.latencies()
+        || a.secureFlags() != b.secureFlags() || a.parents() != b.parents()) {
+        return false;
+    }
+    for (int node = 0; node < a.size(); ++node) {
+        ChildRange x = a.children(node), y = b.children(node);
+        if (!std::equal(x.begin(), x.end(), y.begin(), y.end())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Function to return the message loadWorkflow throws for a file with the given contents
+std::string loadError(const std::string& path, const std::string& contents) {
+    std::ofstream(path, std::ios::binary) << contents;
+    try {
+        loadWorkflow(path);
+    } catch (const std::runtime_error& e) {
+        return e.what();
+    }
+    return "";
+}
+
+} // namespace
+
+int main() {
+    const std::string directory = std::filesystem::temp_directory_path().string();
+    const std::string textPath = directory + "/sasap_workflow_io_test.csv";
+    const std::string binaryPath = directory + "/sasap_workflow_io_test.bin";
+
+    for (TreeShape shape : { TreeShape::Random, TreeShape::Chain, TreeShape::Star, TreeShape::PowerLaw }) {
+        WorkflowTree tree = generateTree(5000, 700, { 1, 20 }, { 1, 10 }, 5, shape);
+        saveWorkflowText(tree, textPath);
+        saveWorkflowBinary(tree, binaryPath);
+        SASAP_CHECK(sameTree(tree, loadWorkflowText(textPath)));
+        SASAP_CHECK(sameTree(tree, loadWorkflowBinary(binaryPath)));
+        SASAP_CHECK(sameTree(tree, loadWorkflow(textPath)));
+        SASAP_CHECK(sameTree(tree, loadWorkflow(binaryPath)));
+    }
+    WorkflowTree empty;
+    saveWorkflowText(empty, textPath);
+    SASAP_CHECK(loadWorkflow(textPath).empty());
+
+    // Hand-written files: any order, other separators, no newline at the end
+    std::ofstream(textPath, std::ios::binary) << "# comment\n2 5 1 true 0\n0,3,2,0,-1\n1\t4\t1\tfalse\t0";
+    WorkflowTree reordered = loadWorkflow(textPath);
+    SASAP_CHECK(reordered.size() == 3 && reordered.root() == 0 && reordered.isSecure(2) && reordered.cost(1) == 4);
+
+    // A huge identifier is rejected at its line instead of sizing the columns after it
+    std::string error = loadError(textPath, "id,cost,latency,secure,parent\n0,1,1,0,-1\n2000000000,1,1,0,0\n");
+    SASAP_CHECK(error.find(textPath + ":3:") == 0);
+    error = loadError(textPath, "0,1,1,0,-1\n2,1,1,0,0\n");
+    SASAP_CHECK(error.find(textPath + ":2:") == 0);
+    error = loadError(textPath, "# padding\n0,1,1,0,-1\n1,1,1,0,0\n3,1,1,0,0\n");
+    SASAP_CHECK(error.find("node 2 is missing") != std::string::npos);
+
+    std::remove(textPath.c_str());
+    std::remove(binaryPath.c_str());
+    return test::finishTests("WorkflowIOTest");
+}
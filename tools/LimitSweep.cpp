@@ -0,0 +1,248 @@
+/*
+
+   Sweep of the SASAP latency and memory limits (and the secure ratio) over one workflow,
+   evaluated in parallel in a single invocation. Every grid point is reported as one CSV row
+   or JSON object with its partition count, QoS satisfaction against the service target and
+   inter-partition linkage count, and whether it lies on the Pareto front of the three (per
+   secure ratio).
+
+   Example:
+     ./limit_sweep --nodes 100000 --latency-limits 25,50,100,200 --memory-limits 50,100,200,400
+                   --secure-ratios 0,0.2 --pareto-only 1
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../sasap/LimitSweep.h"
+#include "../sasap/Profiler.h"
+#include "../sasap/WorkStealingPool.h"
+#include "../sasap/WorkflowIO.h"
+#include "../sasap/WorkflowTree.h"
+
+using namespace std;
+using sasap::WorkflowTree;
+
+// Parameters of one sweep
+struct SweepConfig {
+    string input;                 // Workflow file; empty generates a tree
+    int nodes = 10000;
+    sasap::TreeShape shape = sasap::TreeShape::Random;
+    uint64_t seed = 42;
+    sasap::WeightRange cost = { 1, 20 };
+    sasap::WeightRange latency = { 1, 10 };
+    sasap::SweepGrid grid;
+    sasap::SweepOptions options;
+    bool paretoOnly = false;
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    string format = "csv";
+    string output;                // Empty writes to standard output
+};
+
+// Function to split a comma separated list
+vector<string> splitList(const string& text) {
+    vector<string> items;
+    stringstream stream(text);
+    string item;
+    while (getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+template <typename T, typename Parse>
+vector<T> parseList(const string& text, Parse parse) {
+    vector<T> values;
+    for (const string& item : splitList(text)) {
+        values.push_back(parse(item));
+    }
+    if (values.empty()) {
+        throw invalid_argument("empty list: " + text);
+    }
+    return values;
+}
+
+// Function to parse "min:max"
+sasap::WeightRange parseRange(const string& text) {
+    size_t colon = text.find(':');
+    if (colon == string::npos) {
+        throw invalid_argument("expected min:max, got " + text);
+    }
+    sasap::WeightRange range = { stoi(text.substr(0, colon)), stoi(text.substr(colon + 1)) };
+    if (range.min > range.max) {
+        throw invalid_argument("empty range: " + text);
+    }
+    return range;
+}
+
+void printUsage(const char* program) {
+    cerr << "Usage: " << program << " [options]\n"
+         << "  --input PATH           workflow file (default: generate a tree)\n"
+         << "  --nodes N              nodes of the generated tree (default 10000)\n"
+         << "  --shape NAME           random,chain,star,binary,kary,caterpillar,powerlaw\n"
+         << "  --seed S               tree generator seed (default 42)\n"
+         << "  --cost MIN:MAX         node cost range (default 1:20)\n"
+         << "  --latency MIN:MAX      node latency range (default 1:10)\n"
+         << "  --latency-limits LIST  latency limits (default 50)\n"
+         << "  --memory-limits LIST   memory limits (default 100)\n"
+         << "  --secure-ratios LIST   fraction of secure nodes (default: the tree's own flags)\n"
+         << "  --partitioner NAME     placement|locality|minimum (default placement)\n"
+         << "  --policy NAME          placement: first-fit|best-fit|worst-fit\n"
+         << "  --qos-latency L        latency target of the QoS score (default 50)\n"
+         << "  --qos-cost C           cost target of the QoS score (default 100)\n"
+         << "  --pareto-only 0|1      report only the Pareto front (default 0)\n"
+         << "  --threads N            worker threads (default: all hardware threads)\n"
+         << "  --format csv|json      output format (default csv)\n"
+         << "  --output PATH          output file (default standard output)" << endl;
+}
+
+// Function to read the command line into a sweep configuration
+SweepConfig parseArguments(int argc, char* argv[]) {
+    SweepConfig config;
+    for (int i = 1; i < argc; i += 2) {
+        string key = argv[i];
+        if (i + 1 >= argc) {
+            throw invalid_argument("missing value for " + key);
+        }
+        string value = argv[i + 1];
+        if (key == "--input") {
+            config.input = value;
+        } else if (key == "--nodes") {
+            config.nodes = stoi(value);
+        } else if (key == "--shape") {
+            config.shape = sasap::parseTreeShape(value);
+        } else if (key == "--seed") {
+            config.seed = stoull(value);
+        } else if (key == "--cost") {
+            config.cost = parseRange(value);
+        } else if (key == "--latency") {
+            config.latency = parseRange(value);
+        } else if (key == "--latency-limits") {
+            config.grid.latencyLimits = parseList<int>(value, [](const string& s) { return stoi(s); });
+        } else if (key == "--memory-limits") {
+            config.grid.memoryLimits = parseList<int>(value, [](const string& s) { return stoi(s); });
+        } else if (key == "--secure-ratios") {
+            config.grid.secureRatios = parseList<double>(value, [](const string& s) { return stod(s); });
+        } else if (key == "--partitioner") {
+            config.options.partitioner = sasap::parseSweepPartitioner(value);
+        } else if (key == "--policy") {
+            config.options.policy = sasap::parsePlacementPolicy(value);
+        } else if (key == "--qos-latency") {
+            config.options.qosLatencyLimit = stoi(value);
+        } else if (key == "--qos-cost") {
+            config.options.qosCostLimit = stoi(value);
+        } else if (key == "--pareto-only") {
+            config.paretoOnly = stoi(value) != 0;
+        } else if (key == "--threads") {
+            config.threads = static_cast<unsigned>(stoul(value));
+        } else if (key == "--format") {
+            config.format = value;
+        } else if (key == "--output") {
+            config.output = value;
+        } else {
+            throw invalid_argument("unknown option: " + key);
+        }
+    }
+
+    if (config.nodes < 1 || config.threads < 1 || config.options.qosLatencyLimit < 1 || config.options.qosCostLimit < 1
+        || (config.format != "csv" && config.format != "json")) {
+        throw invalid_argument("nodes, threads and QoS targets must be positive and format csv or json");
+    }
+    return config;
+}
+
+void writeCsv(ostream& out, const vector<sasap::SweepResult>& results, const SweepConfig& config) {
+    out << "partitioner,latency_limit,memory_limit,secure_ratio,partitions,qos,linkages,partition_pairs,ms,pareto\n";
+    for (const sasap::SweepResult& result : results) {
+        out << sasap::sweepPartitionerName(config.options.partitioner) << ',' << result.latencyLimit << ','
+            << result.memoryLimit << ',' << result.secureRatio << ',' << result.partitions << ',' << result.qos << ','
+            << result.linkages << ',' << result.partitionPairs << ',' << result.millis << ',' << (result.pareto ? 1 : 0) << '\n';
+    }
+}
+
+void writeJson(ostream& out, const vector<sasap::SweepResult>& results, const SweepConfig& config) {
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const sasap::SweepResult& result = results[i];
+        out << "  {\"partitioner\": \"" << sasap::sweepPartitionerName(config.options.partitioner)
+            << "\", \"latency_limit\": " << result.latencyLimit << ", \"memory_limit\": " << result.memoryLimit
+            << ", \"secure_ratio\": " << result.secureRatio << ", \"partitions\": " << result.partitions
+            << ", \"qos\": " << result.qos << ", \"linkages\": " << result.linkages
+            << ", \"partition_pairs\": " << result.partitionPairs << ", \"ms\": " << result.millis
+            << ", \"pareto\": " << (result.pareto ? "true" : "false") << "}" << (i + 1 < results.size() ? "," : "") << '\n';
+    }
+    out << "]\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 2 && (string(argv[1]) == "--help" || string(argv[1]) == "-h")) {
+        printUsage(argv[0]);
+        return 0;
+    }
+
+    SweepConfig config;
+    try {
+        config = parseArguments(argc, argv);
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        // The pool builds the tree and then evaluates the grid
+        sasap::WorkStealingPool pool(config.threads);
+        auto start = chrono::steady_clock::now();
+        WorkflowTree tree = config.input.empty()
+                                ? sasap::generateTree(config.nodes, 0, config.cost, config.latency, config.seed, config.shape, &pool)
+                                : sasap::loadWorkflow(config.input);
+        chrono::duration<double> built = chrono::steady_clock::now() - start;
+
+        vector<sasap::SweepResult> results = sasap::sweepLimits(tree, config.grid, config.options, pool);
+        chrono::duration<double> swept = chrono::steady_clock::now() - start - built;
+        size_t points = results.size();
+        size_t front = count_if(results.begin(), results.end(), [](const sasap::SweepResult& result) { return result.pareto; });
+        if (config.paretoOnly) {
+            results.erase(remove_if(results.begin(), results.end(), [](const sasap::SweepResult& result) { return !result.pareto; }),
+                          results.end());
+        }
+
+        ofstream file;
+        if (!config.output.empty()) {
+            file.open(config.output);
+            if (!file) {
+                cerr << "Cannot open " << config.output << endl;
+                return 1;
+            }
+        }
+        ostream& out = config.output.empty() ? cout : file;
+        if (config.format == "csv") {
+            writeCsv(out, results, config);
+        } else {
+            writeJson(out, results, config);
+        }
+        cerr << tree.size() << " nodes " << (config.input.empty() ? "generated" : "loaded") << " in " << built.count()
+             << " seconds; " << points << " points on " << pool.size() << " threads in "
+             << swept.count() << " seconds, " << front << " on the Pareto front" << endl;
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    string profile = sasap::writeProfileFromEnvironment();   // Only when SASAP_PROFILE names an output prefix
+    if (!profile.empty()) {
+        cerr << "Profile: " << profile << ".profile.json, " << profile << ".trace.json" << endl;
+    }
+    return 0;
+}
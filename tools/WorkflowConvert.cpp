@@ -0,0 +1,76 @@
+/*
+
+   Conversion between the workflow file formats, and generation of random workflow files.
+
+     ./workflow_convert <input> <output.csv|output.bin>
+     ./workflow_convert --generate <nodes> <secure_nodes> <output.csv|output.bin> [seed] [shape]
+
+   The input format is detected from its header; the output is binary when its name ends in
+   ".bin" and text otherwise. Generated trees are built on all hardware threads.
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "../sasap/WorkStealingPool.h"
+#include "../sasap/WorkflowIO.h"
+#include "../sasap/WorkflowTree.h"
+
+using namespace std;
+using sasap::WorkflowTree;
+
+// Function to test whether a path names a binary workflow file
+bool isBinaryPath(const string& path) {
+    return path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+}
+
+int main(int argc, char* argv[]) {
+    bool generate = argc >= 2 && string(argv[1]) == "--generate";
+    if ((!generate && argc != 3) || (generate && (argc < 5 || argc > 7))) {
+        cerr << "Usage: " << argv[0] << " <input> <output.csv|output.bin>" << endl
+             << "       " << argv[0] << " --generate <nodes> <secure_nodes> <output.csv|output.bin> [seed] [random|chain|star|binary|kary|caterpillar|powerlaw]" << endl;
+        return 1;
+    }
+
+    try {
+        auto start = chrono::steady_clock::now();
+        WorkflowTree tree;
+        string output;
+        if (generate) {
+            int numNodes = stoi(argv[2]);
+            int secureNodeCount = stoi(argv[3]);
+            if (numNodes < 1 || secureNodeCount < 0 || secureNodeCount > numNodes) {
+                cerr << "Number of nodes must be at least 1 and secure nodes between 0 and the number of nodes." << endl;
+                return 1;
+            }
+            output = argv[4];
+            uint64_t seed = argc >= 6 ? stoull(argv[5]) : 42;
+            sasap::TreeShape shape = argc == 7 ? sasap::parseTreeShape(argv[6]) : sasap::TreeShape::Random;
+            sasap::WorkStealingPool pool(max(1u, thread::hardware_concurrency()));
+            tree = sasap::generateTree(numNodes, secureNodeCount, {1, 20}, {1, 10}, seed, shape, &pool);
+        } else {
+            tree = sasap::loadWorkflow(argv[1]);
+            output = argv[2];
+        }
+        chrono::duration<double> loaded = chrono::steady_clock::now() - start;
+
+        if (isBinaryPath(output)) {
+            sasap::saveWorkflowBinary(tree, output);
+        } else {
+            sasap::saveWorkflowText(tree, output);
+        }
+        chrono::duration<double> total = chrono::steady_clock::now() - start;
+        cout << tree.size() << " nodes " << (generate ? "generated" : "loaded") << " in " << loaded.count()
+             << " seconds, written to " << output << " in " << (total - loaded).count() << " seconds." << endl;
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}